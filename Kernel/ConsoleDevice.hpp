@@ -20,9 +20,9 @@ namespace Kernel {
         , public VirtualFile
     {
     public:
-        VirtualFileHandle& create_handle_impl() override
+        VirtualFileHandle& create_handle_impl(ProcessHeap *heap) override
         {
-            return *new ConsoleFileHandle;
+            return construct_handle<ConsoleFileHandle>(heap);
         }
 
         void truncate() override
@@ -23,9 +23,12 @@ namespace Kernel
             m_devices.set(device_id, &file);
         }
 
-        VirtualFileHandle& create_device_handle(u32 device_id)
+        VirtualFileHandle& create_device_handle(u32 device_id, ProcessHeap *heap = nullptr)
         {
-            return m_devices.get_opt(device_id).must()->create_handle();
+            VirtualFile **file = m_devices.get(device_id);
+            VERIFY(file != nullptr);
+
+            return (*file)->create_handle(heap);
         }
 
     private:
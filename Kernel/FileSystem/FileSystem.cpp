@@ -4,41 +4,50 @@
 
 namespace Kernel::FileSystem
 {
-    VirtualFile& lookup(Path path)
+    VirtualFile& lookup(const Path& path)
     {
         VERIFY(path.is_absolute());
 
         VirtualFile *file = &MemoryFileSystem::the().root();
 
-        for (auto& component : path.components()) {
+        for (StringView component : path.components()) {
             auto *directory = dynamic_cast<VirtualDirectory*>(file);
             ASSERT(directory != nullptr);
 
-            file = directory->m_entries.get_opt(component).must();
+            VirtualFile **entry = directory->m_entries.get(Atom::lookup(component).must());
+            VERIFY(entry != nullptr);
+
+            file = *entry;
         }
 
         ASSERT(file != nullptr);
         return *file;
     }
 
-    KernelResult<VirtualFile*> try_lookup(Path path)
+    KernelResult<VirtualFile*> try_lookup(const Path& path)
     {
         VERIFY(path.is_absolute());
 
         VirtualFile *file = &MemoryFileSystem::the().root();
 
-        for (auto& component : path.components()) {
+        for (StringView component : path.components()) {
             auto *directory = dynamic_cast<VirtualDirectory*>(file);
 
             if (directory == nullptr)
                 return ENOTDIR;
 
-            auto file_opt = directory->m_entries.get_opt(component);
+            // If no atom exists for this name, no directory can have an entry with that name
+            auto name_opt = Atom::lookup(component);
 
-            if (!file_opt.is_valid())
+            if (!name_opt.is_valid())
                 return ENOENT;
 
-            file = file_opt.value();
+            VirtualFile **entry = directory->m_entries.get(name_opt.value());
+
+            if (entry == nullptr)
+                return ENOENT;
+
+            file = *entry;
         }
 
         ASSERT(file != nullptr);
@@ -54,6 +63,9 @@ namespace Kernel::FileSystem
 
     VirtualFileHandle& create_handle_for_device(u32 device)
     {
-        return devices.get_opt(device).must()->create_handle();
+        VirtualFile **file = devices.get(device);
+        VERIFY(file != nullptr);
+
+        return (*file)->create_handle();
     }
 }
@@ -7,9 +7,9 @@
 namespace Kernel::FileSystem
 {
     // FIXME: Remove this function, try_lookup should take this name
-    VirtualFile& lookup(Path);
+    VirtualFile& lookup(const Path&);
 
-    KernelResult<VirtualFile*> try_lookup(Path);
+    KernelResult<VirtualFile*> try_lookup(const Path&);
 
     void add_device(u32 device, VirtualFile&);
     VirtualFileHandle& create_handle_for_device(u32 device);
@@ -14,9 +14,9 @@ namespace Kernel
         VERIFY(m_root->m_ino == 2);
     }
 
-    VirtualFileHandle& FlashFile::create_handle_impl()
+    VirtualFileHandle& FlashFile::create_handle_impl(ProcessHeap *heap)
     {
-        return *new FlashFileHandle { *this };
+        return construct_handle<FlashFileHandle>(heap, *this);
     }
 
     FlashDirectory::FlashDirectory(FileInfo& info)
@@ -45,8 +45,8 @@ namespace Kernel
         }
     }
 
-    VirtualFileHandle& FlashDirectory::create_handle_impl()
+    VirtualFileHandle& FlashDirectory::create_handle_impl(ProcessHeap *heap)
     {
-        return *new FlashDirectoryHandle { *this };
+        return construct_handle<FlashDirectoryHandle>(heap, *this);
     }
 }
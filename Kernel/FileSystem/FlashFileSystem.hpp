@@ -38,7 +38,7 @@ namespace Kernel
             m_size = info.st_size;
         }
 
-        VirtualFileHandle& create_handle_impl() override;
+        VirtualFileHandle& create_handle_impl(ProcessHeap*) override;
 
         void truncate() override
         {
@@ -78,7 +78,7 @@ namespace Kernel
     public:
         explicit FlashDirectory(FileInfo& info);
 
-        VirtualFileHandle& create_handle_impl() override;
+        VirtualFileHandle& create_handle_impl(ProcessHeap*) override;
     };
 
     // FIXME: This is redundant with MemoryDirectoryHandle
@@ -24,13 +24,13 @@ namespace Kernel
         m_root->m_entries.set("bin", &bin_directory);
     }
 
-    VirtualFileHandle& MemoryFile::create_handle_impl()
+    VirtualFileHandle& MemoryFile::create_handle_impl(ProcessHeap *heap)
     {
-        return *new MemoryFileHandle { *this };
+        return construct_handle<MemoryFileHandle>(heap, *this);
     }
 
-    VirtualFileHandle& MemoryDirectory::create_handle_impl()
+    VirtualFileHandle& MemoryDirectory::create_handle_impl(ProcessHeap *heap)
     {
-        return *new MemoryDirectoryHandle { *this };
+        return construct_handle<MemoryDirectoryHandle>(heap, *this);
     }
 }
@@ -42,7 +42,7 @@ namespace Kernel
         ReadonlyBytes span() const { return m_data.span(); }
         Bytes span() { return m_data.span(); }
 
-        VirtualFileHandle& create_handle_impl() override;
+        VirtualFileHandle& create_handle_impl(ProcessHeap*) override;
 
         void truncate() override
         {
@@ -101,7 +101,7 @@ namespace Kernel
             m_entries.set("..", this);
         }
 
-        VirtualFileHandle& create_handle_impl() override;
+        VirtualFileHandle& create_handle_impl(ProcessHeap*) override;
     };
 
     class MemoryDirectoryHandle final : public VirtualFileHandle {
@@ -3,11 +3,11 @@
 
 namespace Kernel
 {
-    VirtualFileHandle& VirtualFile::create_handle()
+    VirtualFileHandle& VirtualFile::create_handle(ProcessHeap *heap)
     {
         if ((m_mode & ModeFlags::Format) == ModeFlags::Device)
-            return DeviceFileSystem::the().create_device_handle(m_device_id);
+            return DeviceFileSystem::the().create_device_handle(m_device_id, heap);
         else
-            return create_handle_impl();
+            return create_handle_impl(heap);
     }
 }
@@ -2,8 +2,10 @@
 
 #include <Std/HashMap.hpp>
 #include <Std/String.hpp>
+#include <Std/Atom.hpp>
 
 #include <Kernel/Result.hpp>
+#include <Kernel/ProcessHeap.hpp>
 #include <Kernel/Interface/Types.hpp>
 
 namespace Kernel
@@ -43,8 +45,9 @@ namespace Kernel
 
         virtual void truncate() = 0;
 
-        VirtualFileHandle& create_handle();
-        virtual VirtualFileHandle& create_handle_impl() = 0;
+        // If a heap is provided, the handle lives as long as the process that owns the heap
+        VirtualFileHandle& create_handle(ProcessHeap *heap = nullptr);
+        virtual VirtualFileHandle& create_handle_impl(ProcessHeap*) = 0;
     };
 
     class VirtualDirectory : public VirtualFile {
@@ -56,7 +59,7 @@ namespace Kernel
             VERIFY_NOT_REACHED();
         }
 
-        HashMap<String, VirtualFile*> m_entries;
+        HashMap<Atom, VirtualFile*> m_entries;
     };
 
     class VirtualFileHandle {
@@ -66,4 +69,13 @@ namespace Kernel
         virtual KernelResult<usize> read(Bytes) = 0;
         virtual KernelResult<usize> write(ReadonlyBytes) = 0;
     };
+
+    template<typename T, typename... Parameters>
+    VirtualFileHandle& construct_handle(ProcessHeap *heap, Parameters&&... parameters)
+    {
+        if (heap != nullptr)
+            return heap->construct<T>(forward<Parameters>(parameters)...);
+
+        return *new T { forward<Parameters>(parameters)... };
+    }
 }
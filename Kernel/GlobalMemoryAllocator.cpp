@@ -1,11 +1,83 @@
 #include <Kernel/GlobalMemoryAllocator.hpp>
 #include <Kernel/PageAllocator.hpp>
+#include <Kernel/Threads/Scheduler.hpp>
 
 namespace Kernel
 {
     GlobalMemoryAllocator::GlobalMemoryAllocator()
-        : MemoryAllocator(allocate_heap())
+        : CachingAllocator(allocate_heap())
     {
+        m_grow_callback = grow_heap;
+        m_release_callback = release_heap_region;
+    }
+
+    Bytes GlobalMemoryAllocator::grow_heap(usize size)
+    {
+        // The page allocator must not be locked in handler mode
+        if (is_executing_in_handler_mode())
+            return {};
+
+        usize power = min_region_power;
+        while ((usize(1) << power) < size)
+            ++power;
+
+        if (power > PageAllocator::max_power)
+            return {};
+
+        auto range = PageAllocator::the().allocate(power);
+        if (!range.is_valid())
+            return {};
+
+        if (debug_global_memory_allocator)
+            dbgln("[GlobalMemoryAllocator::grow_heap] Adding {} bytes at {}", range.value().size(), range.value().data());
+
+        // The range is handed back in 'release_heap_region'
+        Bytes bytes = range.value().bytes();
+        range.value().m_range.clear();
+
+        return bytes;
+    }
+
+    void GlobalMemoryAllocator::release_heap_region(Bytes bytes)
+    {
+        // The region stays in the heap until it becomes free again in thread mode
+        if (is_executing_in_handler_mode()) {
+            GlobalMemoryAllocator::the().add_region(bytes);
+            return;
+        }
+
+        if (debug_global_memory_allocator)
+            dbgln("[GlobalMemoryAllocator::release_heap_region] Removing {} bytes at {}", bytes.size(), bytes.data());
+
+        OwnedPageRange range { PageRange { power_of_two(bytes.size()), uptr(bytes.data()) } };
+    }
+
+    void GlobalMemoryAllocator::start_trace()
+    {
+        InterruptGuard guard;
+
+        // Blocks that are already allocated can not be attributed to a caller
+        auto stats = GlobalMemoryAllocatorBackend::statistics();
+        Std::HeapTrace::start(heap_size() - stats.m_avaliable_memory - stats.m_size_class_memory);
+
+        for_each_region([](Bytes bytes) {
+            Std::HeapTrace::add_region(bytes);
+        });
+
+        m_debug = true;
+    }
+
+    AllocationCache* GlobalMemoryAllocator::current_cache()
+    {
+        // A handler may interrupt the active thread while it is using its cache
+        if (!Scheduler::is_initialized() || is_executing_in_handler_mode())
+            return nullptr;
+
+        Thread *thread = Scheduler::the().active_thread_if_avaliable();
+        if (thread == nullptr)
+            return nullptr;
+
+        return &thread->m_allocation_cache;
     }
 
     Bytes GlobalMemoryAllocator::allocate_heap()
@@ -18,46 +90,46 @@ namespace Kernel
 void* operator new(usize size)
 {
     void *address = __builtin_return_address(0);
-    return Kernel::GlobalMemoryAllocator::the().allocate(size, true, address);
+    return Kernel::GlobalMemoryAllocator::the().allocate(Kernel::GlobalMemoryAllocator::current_cache(), size, true, address);
 }
 void* operator new[](usize size)
 {
     void *address = __builtin_return_address(0);
-    return Kernel::GlobalMemoryAllocator::the().allocate(size, true, address);
+    return Kernel::GlobalMemoryAllocator::the().allocate(Kernel::GlobalMemoryAllocator::current_cache(), size, true, address);
 }
 void operator delete(void* pointer)
 {
     void *address = __builtin_return_address(0);
-    return Kernel::GlobalMemoryAllocator::the().deallocate(reinterpret_cast<u8*>(pointer), true, address);
+    return Kernel::GlobalMemoryAllocator::the().deallocate(Kernel::GlobalMemoryAllocator::current_cache(), reinterpret_cast<u8*>(pointer), true, address);
 }
 void operator delete[](void* pointer)
 {
     void *address = __builtin_return_address(0);
-    return Kernel::GlobalMemoryAllocator::the().deallocate(reinterpret_cast<u8*>(pointer), true, address);
+    return Kernel::GlobalMemoryAllocator::the().deallocate(Kernel::GlobalMemoryAllocator::current_cache(), reinterpret_cast<u8*>(pointer), true, address);
 }
 void operator delete(void* pointer, usize)
 {
     void *address = __builtin_return_address(0);
-    return Kernel::GlobalMemoryAllocator::the().deallocate(reinterpret_cast<u8*>(pointer), true, address);
+    return Kernel::GlobalMemoryAllocator::the().deallocate(Kernel::GlobalMemoryAllocator::current_cache(), reinterpret_cast<u8*>(pointer), true, address);
 }
 void operator delete[](void* pointer, usize)
 {
     void *address = __builtin_return_address(0);
-    return Kernel::GlobalMemoryAllocator::the().deallocate(reinterpret_cast<u8*>(pointer), true, address);
+    return Kernel::GlobalMemoryAllocator::the().deallocate(Kernel::GlobalMemoryAllocator::current_cache(), reinterpret_cast<u8*>(pointer), true, address);
 }
 
 extern "C"
-void* malloc(usize size)
+void* malloc(usize size) noexcept
 {
     void *address = __builtin_return_address(0);
-    return Kernel::GlobalMemoryAllocator::the().allocate(size, true, address);
+    return Kernel::GlobalMemoryAllocator::the().allocate(Kernel::GlobalMemoryAllocator::current_cache(), size, true, address);
 }
 
 extern "C"
-void* calloc(usize nmembers, usize size)
+void* calloc(usize nmembers, usize size) noexcept
 {
     void *address = __builtin_return_address(0);
-    u8 *pointer = Kernel::GlobalMemoryAllocator::the().allocate(nmembers * size, true, address);
+    u8 *pointer = Kernel::GlobalMemoryAllocator::the().allocate(Kernel::GlobalMemoryAllocator::current_cache(), nmembers * size, true, address);
 
     __builtin_memset(pointer, 0, nmembers * size);
 
@@ -65,21 +137,21 @@ void* calloc(usize nmembers, usize size)
 }
 
 extern "C"
-void free(void *pointer)
+void free(void *pointer) noexcept
 {
     void *address = __builtin_return_address(0);
-    return Kernel::GlobalMemoryAllocator::the().deallocate(reinterpret_cast<u8*>(pointer), true, address);
+    return Kernel::GlobalMemoryAllocator::the().deallocate(Kernel::GlobalMemoryAllocator::current_cache(), reinterpret_cast<u8*>(pointer), true, address);
 }
 
 extern "C"
-void* realloc(void *pointer, usize size)
+void* realloc(void *pointer, usize size) noexcept
 {
     void *address = __builtin_return_address(0);
     return Kernel::GlobalMemoryAllocator::the().reallocate(reinterpret_cast<u8*>(pointer), size, true, address);
 }
 
 extern "C"
-void* reallocarray(void *pointer, usize nmembers, usize size)
+void* reallocarray(void *pointer, usize nmembers, usize size) noexcept
 {
     void *address = __builtin_return_address(0);
     return Kernel::GlobalMemoryAllocator::the().reallocate(reinterpret_cast<u8*>(pointer), nmembers * size, true, address);
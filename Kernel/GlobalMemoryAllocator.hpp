@@ -1,21 +1,52 @@
 #pragma once
 
 #include <Std/Singleton.hpp>
-#include <Std/MemoryAllocator.hpp>
+#include <Std/CachingAllocator.hpp>
 
 #include <Kernel/Forward.hpp>
 #include <Kernel/PageAllocator.hpp>
+#include <Kernel/HandlerMode.hpp>
 
 namespace Kernel
 {
+    // The TLSF allocator has a bounded worst case, the free list allocator wastes less memory for small objects
+#if defined(KERNEL_TLSF_ALLOCATOR)
+    using GlobalMemoryAllocatorBackend = TlsfAllocator;
+#else
+    using GlobalMemoryAllocatorBackend = MemoryAllocator;
+#endif
+
+    constexpr bool debug_global_memory_allocator = false;
+
+    // Threads can be preempted at any time, the shared heap is only accessed with interrupts masked.  Small
+    // allocations of a thread are served from its own 'AllocationCache' instead, see 'Thread::m_allocation_cache'.
+    //
+    // The heap starts out with a single range of pages and grows by further ranges once it is exhausted.  Ranges
+    // that become entirely free are returned to the page allocator.
     class GlobalMemoryAllocator
         : public Singleton<GlobalMemoryAllocator>
-        , public MemoryAllocator
+        , public CachingAllocator<GlobalMemoryAllocatorBackend, InterruptGuard>
     {
+    public:
+        // The cache of the active thread, or null in handler mode and before the scheduler runs
+        static AllocationCache* current_cache();
+
+        // Hands out a range of pages for 'm_grow_callback', it is returned to the page allocator with its power
+        static Bytes grow_heap(usize size);
+
+        // Reports the regions of the heap and every operation from now on, see 'Std/HeapTrace.hpp'.  This requires
+        // the kernel log to be running.
+        void start_trace();
+
     private:
         friend Singleton<GlobalMemoryAllocator>;
         GlobalMemoryAllocator();
 
+        // Smaller ranges would mostly hold the overhead of the region
+        static constexpr usize min_region_power = power_of_two(0x1000);
+
+        static void release_heap_region(Bytes);
+
         Optional<OwnedPageRange> m_heap;
 
         Bytes allocate_heap();
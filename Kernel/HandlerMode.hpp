@@ -41,6 +41,33 @@ namespace Kernel
         return (control & 1) == 0;
     }
 
+    // Masks interrupts for the lifetime of the object, restores the previous state afterwards, thus these can be nested.
+    // The RP2040 cores do not implement exclusive loads and stores, this is used instead for short critical sections.
+    class InterruptGuard {
+    public:
+        InterruptGuard()
+        {
+            asm volatile ("mrs %0, primask;"
+                          "cpsid i;"
+                : "=r"(m_primask)
+                :
+                : "memory");
+        }
+        ~InterruptGuard()
+        {
+            asm volatile ("msr primask, %0;"
+                :
+                : "r"(m_primask)
+                : "memory");
+        }
+
+        InterruptGuard(const InterruptGuard&) = delete;
+        InterruptGuard& operator=(const InterruptGuard&) = delete;
+
+    private:
+        u32 m_primask;
+    };
+
     // FIXME: Some of this code is redundant with the scheduler
 
     template<typename T, void (T::*Method)()>
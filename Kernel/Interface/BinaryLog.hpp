@@ -0,0 +1,47 @@
+#pragma once
+
+#if !defined(KERNEL) && !defined(HOST) && !defined(TEST)
+# error "KERNEL, HOST or TEST needs to be defined"
+#endif
+
+#include <Std/Types.hpp>
+
+// If the kernel is built with 'KERNEL_BINARY_LOG', 'dbgln' emits records instead of text.  The format strings are
+// placed in the '.kernel_log_strings' section which is not loaded, 'Tools/LogDecoder' renders the records on the host.
+//
+// GCC ignores the section attribute on static variables in templates, these format strings remain in '.rodata'
+// and the decoder looks them up by address in the other sections.
+namespace Kernel::BinaryLog
+{
+    constexpr const char *section_name = ".kernel_log_strings";
+
+    // Everything on the console that does not start with these bytes is passed through as text
+    constexpr u8 magic[] = { 0x1e, 0xb1 };
+
+    struct [[gnu::packed]] RecordHeader {
+        u8 m_magic[2];
+
+        // Size of the encoded arguments that follow the header
+        u16 m_size;
+
+        // Address of the null terminated format string, '.kernel_log_strings' starts at address zero
+        u32 m_string_address;
+    };
+    static_assert(sizeof(RecordHeader) == 8);
+
+    // Each argument starts with a tag.  For numbers, the lower bits hold the size in bytes and the value follows
+    // in little endian.  Strings are followed by a 'u16' length and the characters.
+    enum class Tag : u8 {
+        Unsigned = 0x10,
+        Signed = 0x20,
+        Pointer = 0x30,
+        Char = 0x40,
+        Bool = 0x50,
+
+        // Used for all types without a binary representation, these are formatted on the device
+        String = 0x60,
+    };
+
+    constexpr u8 tag_kind_mask = 0xf0;
+    constexpr u8 tag_size_mask = 0x0f;
+}
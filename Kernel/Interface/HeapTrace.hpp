@@ -0,0 +1,49 @@
+#pragma once
+
+#if !defined(KERNEL) && !defined(HOST) && !defined(TEST)
+# error "KERNEL, HOST or TEST needs to be defined"
+#endif
+
+#include <Std/Types.hpp>
+
+// If the kernel is built with 'KERNEL_HEAP_TRACE', every operation on the global heap is written to the console as
+// a fixed size event.  The events are mixed with the other output and are analyzed by 'Tools/HeapProfiler'.
+namespace Kernel::HeapTrace
+{
+    // Shares the first byte with the records of 'Kernel/Interface/BinaryLog.hpp'
+    constexpr u8 magic[] = { 0x1e, 0xb2 };
+
+    enum class Kind : u8 {
+        // Blocks that were allocated before the trace started, 'm_size' holds the number of bytes in use
+        Start = 1,
+
+        Allocate,
+        Deallocate,
+
+        // 'm_pointer' was resized to 'm_size' bytes and moved to 'm_new_pointer', which may be the same
+        Reallocate,
+
+        // The heap grew by 'm_size' bytes at 'm_pointer', or gave them back
+        AddRegion,
+        RemoveRegion,
+    };
+
+    constexpr u8 last_kind = u8(Kind::RemoveRegion);
+
+    struct [[gnu::packed]] Event {
+        u8 m_magic[2];
+        Kind m_kind;
+        u8 m_reserved;
+
+        // Microseconds since boot, this wraps after about 71 minutes
+        u32 m_timestamp;
+
+        // Return address of the function that called into the allocator
+        u32 m_caller;
+
+        u32 m_pointer;
+        u32 m_new_pointer;
+        u32 m_size;
+    };
+    static_assert(sizeof(Event) == 24);
+}
@@ -0,0 +1,80 @@
+#include <Kernel/KernelLog.hpp>
+#include <Kernel/ConsoleDevice.hpp>
+#include <Kernel/Threads/Scheduler.hpp>
+#include <Kernel/Interface/BinaryLog.hpp>
+#include <Kernel/Interface/HeapTrace.hpp>
+
+namespace Kernel
+{
+    // Records of the binary log and heap trace events are decoded on the host, see 'Tools/LogDecoder' and
+    // 'Tools/HeapProfiler'
+    static bool is_binary_record(StringView message)
+    {
+        if (message.size() >= sizeof(BinaryLog::RecordHeader)
+            && u8(message[0]) == BinaryLog::magic[0] && u8(message[1]) == BinaryLog::magic[1])
+            return true;
+
+        return message.size() == sizeof(HeapTrace::Event)
+            && u8(message[0]) == HeapTrace::magic[0] && u8(message[1]) == HeapTrace::magic[1];
+    }
+
+    static void write_line(StringView message)
+    {
+        ConsoleFileHandle handle;
+
+        if (is_binary_record(message)) {
+            handle.write(message.bytes());
+            return;
+        }
+
+        handle.write(StringView { "\e[36m" }.bytes());
+        handle.write(message.bytes());
+        handle.write(StringView { "\e[0m\n" }.bytes());
+    }
+
+    void KernelLog::write(StringView message)
+    {
+        m_buffer.try_append(message);
+
+        // Only after the message was committed, otherwise the drain thread could block again without seeing it.
+        // Dropped messages wake it up as well, they are reported by 'flush'.
+        if (m_drain_thread != nullptr)
+            m_drain_thread->mark_unblocked();
+    }
+
+    void KernelLog::flush()
+    {
+        m_buffer.drain(write_line);
+
+        usize dropped = m_buffer.dropped();
+        if (dropped != m_reported_dropped) {
+            StringBuilder builder;
+            builder.appendf("[KernelLog] Dropped {:d} messages", dropped - m_reported_dropped);
+            write_line(builder.view());
+
+            m_reported_dropped = dropped;
+        }
+    }
+
+    void KernelLog::start_drain_thread()
+    {
+        auto thread = Thread::construct("Kernel (log drain)");
+        thread->m_privileged = true;
+        thread->setup_context([this] {
+            for (;;) {
+                flush();
+
+                // A message that is written after the check unblocks the thread again, thus no message is missed
+                InterruptGuard guard;
+                if (m_buffer.is_empty())
+                    Thread::active().mark_blocked();
+
+                // Switches once the guard is released
+                Scheduler::the().trigger();
+            }
+        });
+
+        m_drain_thread = thread.ptr();
+        Scheduler::the().add_thread(thread);
+    }
+}
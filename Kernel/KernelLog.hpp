@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Std/Singleton.hpp>
+#include <Std/LogBuffer.hpp>
+
+#include <Kernel/Forward.hpp>
+#include <Kernel/HandlerMode.hpp>
+
+namespace Kernel
+{
+    // Collects the output of 'dbgln' in memory and writes it to the console from a separate thread.  Appending a
+    // message does not wait for the UART and does not block, thus 'dbgln' can be used in handler mode.
+    class KernelLog : public Singleton<KernelLog> {
+    public:
+#if defined(KERNEL_HEAP_TRACE)
+        // Every operation on the heap adds an event
+        static constexpr usize buffer_size = 16 * KiB;
+#else
+        static constexpr usize buffer_size = 4 * KiB;
+#endif
+
+        // Wakes up the drain thread, this does not switch to it.
+        void write(StringView message);
+
+        // Writes the buffered messages to the console synchronously.
+        void flush();
+
+        // The thread flushes the log and blocks until further messages are written.
+        void start_drain_thread();
+
+    private:
+        LogBuffer<buffer_size, InterruptGuard> m_buffer;
+        usize m_reported_dropped = 0;
+
+        // The thread is never terminated, thus this is not a strong reference
+        Thread *m_drain_thread = nullptr;
+
+        friend Singleton<KernelLog>;
+        KernelLog() = default;
+    };
+}
@@ -40,6 +40,8 @@ namespace Kernel
                     if (m_holding_thread.is_null()) {
                         m_holding_thread = *active_thread;
                     } else {
+                        // The wait path must not allocate, the heap may have to lock another mutex to grow
+                        VERIFY(m_waiting_threads.size() < max_waiting_threads);
                         m_waiting_threads.enqueue(*active_thread);
                         active_thread->block();
                     }
@@ -70,7 +72,9 @@ namespace Kernel
         }
 
     private:
+        static constexpr usize max_waiting_threads = 16;
+
         RefPtr<Thread> m_holding_thread;
-        CircularQueue<RefPtr<Thread>, 16> m_waiting_threads;
+        CircularQueue<RefPtr<Thread>, max_waiting_threads> m_waiting_threads;
     };
 }
@@ -92,3 +92,7 @@ namespace Kernel
         Array<Block*, max_power + 1> m_blocks;
     };
 }
+
+template<>
+struct Std::IsTriviallyRelocatable<Kernel::OwnedPageRange> : Std::IntegralConstant<bool, true> {
+};
@@ -1,4 +1,5 @@
 #include <Std/OwnPtr.hpp>
+#include <Std/Arena.hpp>
 
 #include <Kernel/Process.hpp>
 #include <Kernel/Threads/Scheduler.hpp>
@@ -15,16 +16,13 @@ namespace Kernel
         return thread.m_process.must();
     }
 
-    Process& Process::create(StringView name, ElfWrapper elf)
+    RefPtr<Process> Process::create(StringView name, ElfWrapper elf)
     {
-        Vector<String> arguments;
-        arguments.append(name);
+        StringView arguments[] { name };
 
-        Vector<String> variables;
-
-        return Process::create(name, elf, arguments, variables);
+        return Process::create(name, elf, { arguments, 1 }, {});
     }
-    Process& Process::create(StringView name, ElfWrapper elf, const Vector<String>& arguments, const Vector<String>& variables)
+    RefPtr<Process> Process::create(StringView name, ElfWrapper elf, Span<const StringView> arguments, Span<const StringView> variables)
     {
         auto process = Process::construct(name);
 
@@ -35,7 +33,23 @@ namespace Kernel
         // FIXME: Is this still required?
         thread->m_privileged = true;
 
-        thread->setup_context([arguments, variables, name, elf]() mutable {
+        // The strings are only needed until they are pushed onto the stack of the new thread, they are copied into
+        // an arena that is released at that point
+        Arena arena;
+
+        auto copy_strings = [&arena](Span<const StringView> strings) {
+            Span<StringView> copies { arena.allocate_array<StringView>(strings.size()), strings.size() };
+            for (usize index = 0; index < strings.size(); ++index)
+                new (&copies[index]) StringView { arena.copy(strings[index]) };
+
+            return copies;
+        };
+
+        Span<StringView> arguments_copy = copy_strings(arguments);
+        Span<StringView> variables_copy = copy_strings(variables);
+        StringView name_copy = arena.copy(name);
+
+        thread->setup_context([arena = move(arena), arguments = arguments_copy, variables = variables_copy, name = name_copy, elf]() mutable {
             dbgln("Loading executable for process '{}' from {}", name, elf.base());
 
             auto& process = Process::active();
@@ -45,10 +59,11 @@ namespace Kernel
 
             StackWrapper stack { { (u8*)executable.m_stack_base, executable.m_stack_size } };
 
-            auto push_cstring_array = [&stack] (const Vector<String>& array) {
-                Vector<char*> pointers;
-                for (auto& value : array.iter()) {
-                    pointers.append(stack.push_cstring(value.cstring()));
+            auto push_cstring_array = [&stack, &arena] (Span<StringView> array) {
+                Vector<char*, 0, ArenaAllocator> pointers { arena };
+                for (StringView value : array.iter()) {
+                    // The copies in the arena are null terminated
+                    pointers.append(stack.push_cstring(value.data()));
                 }
                 char **pointer = (char**)stack.push_value(nullptr);
                 for (size_t i = 0; i < pointers.size(); ++i) {
@@ -113,6 +128,9 @@ namespace Kernel
             dbgln("Handing over execution to process '{}' at {}", name, process.m_executable.must().m_entry);
             dbgln("  Got argv={} and envp={}", argv, envp);
 
+            // Everything that is still needed was copied onto the stack
+            arena.clear();
+
             hand_over_to_loaded_executable(process.m_executable.must(), stack, thread.m_regions, argc, argv, envp);
 
             VERIFY_NOT_REACHED();
@@ -120,6 +138,7 @@ namespace Kernel
 
         Scheduler::the().add_thread(thread);
 
-        return *process;
+        // The process may already be gone if it is not held on to
+        return process;
     }
 }
@@ -6,6 +6,7 @@
 
 #include <Kernel/FileSystem/FileSystem.hpp>
 #include <Kernel/Loader.hpp>
+#include <Kernel/ProcessHeap.hpp>
 
 namespace Kernel
 {
@@ -18,8 +19,8 @@ namespace Kernel
 
         static Process& active();
 
-        static Process& create(StringView name, ElfWrapper);
-        static Process& create(StringView name, ElfWrapper, const Vector<String>& arguments, const Vector<String>& variables);
+        static RefPtr<Process> create(StringView name, ElfWrapper);
+        static RefPtr<Process> create(StringView name, ElfWrapper, Span<const StringView> arguments, Span<const StringView> variables);
 
         i32 add_file_handle(VirtualFileHandle& handle)
         {
@@ -31,39 +32,45 @@ namespace Kernel
 
         VirtualFileHandle& get_file_handle(i32 fd)
         {
-            return *m_handles.get_opt(fd).must();
+            VirtualFileHandle **handle = m_handles.get(fd);
+            VERIFY(handle != nullptr);
+
+            return **handle;
         }
 
+        // Declared first, everything below may allocate from it and must be destroyed before it
+        ProcessHeap m_heap;
+
         Path m_working_directory = "/";
-        String m_name;
+        BasicString<ProcessAllocator> m_name;
         Optional<LoadedExecutable> m_executable;
 
         Process *m_parent = nullptr;
         i32 m_process_id;
-        CircularQueue<TerminatedProcess, 8> m_terminated_children;
+        GrowableCircularQueue<TerminatedProcess, ProcessAllocator> m_terminated_children { m_heap };
 
     private:
         static inline i32 m_next_process_id = 0;
 
-        HashMap<i32, VirtualFileHandle*> m_handles;
+        HashMap<i32, VirtualFileHandle*, ProcessAllocator> m_handles { m_heap };
         i32 m_next_handle_id = 0;
 
         friend RefCounted<Process>;
-        explicit Process(String name, Optional<LoadedExecutable> executable = {})
-            : m_name(move(name))
+        explicit Process(StringView name, Optional<LoadedExecutable> executable = {})
+            : m_name(name, m_heap)
             , m_executable(move(executable))
         {
             m_process_id = m_next_process_id++;
 
             auto& tty_file = FileSystem::lookup("/dev/tty");
 
-            i32 stdin_fileno = add_file_handle(tty_file.create_handle());
+            i32 stdin_fileno = add_file_handle(tty_file.create_handle(&m_heap));
             VERIFY(stdin_fileno == 0);
 
-            i32 stdout_fileno = add_file_handle(tty_file.create_handle());
+            i32 stdout_fileno = add_file_handle(tty_file.create_handle(&m_heap));
             VERIFY(stdout_fileno == 1);
 
-            i32 stderr_fileno = add_file_handle(tty_file.create_handle());
+            i32 stderr_fileno = add_file_handle(tty_file.create_handle(&m_heap));
             VERIFY(stderr_fileno == 2);
         }
     };
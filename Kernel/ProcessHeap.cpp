@@ -0,0 +1,20 @@
+#include <Kernel/ProcessHeap.hpp>
+#include <Kernel/GlobalMemoryAllocator.hpp>
+
+namespace Kernel
+{
+    ProcessHeap::ProcessHeap()
+        : m_range(PageAllocator::the().allocate(initial_power).must())
+        , m_allocator(m_range.bytes())
+    {
+        // The regions are only given back once the process dies
+        m_allocator.m_grow_callback = GlobalMemoryAllocator::grow_heap;
+    }
+
+    ProcessHeap::~ProcessHeap()
+    {
+        m_allocator.release_regions([](Bytes bytes) {
+            OwnedPageRange range { PageRange { power_of_two(bytes.size()), uptr(bytes.data()) } };
+        });
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Std/Allocator.hpp>
+#include <Std/CachingAllocator.hpp>
+
+#include <Kernel/Forward.hpp>
+#include <Kernel/PageAllocator.hpp>
+#include <Kernel/HandlerMode.hpp>
+
+namespace Kernel
+{
+    // Holds the kernel objects of a single process, e.g. its file handles.  They are not destroyed one by one, the
+    // pages of the heap are returned all at once when the process dies.  Thus these objects must not own anything
+    // outside of this heap.
+    //
+    // Other processes may allocate here as well, e.g. a child that reports its exit status to its parent.
+    class ProcessHeap {
+    public:
+        static constexpr usize initial_power = power_of_two(0x400);
+
+        ProcessHeap();
+        ~ProcessHeap();
+
+        ProcessHeap(const ProcessHeap&) = delete;
+        ProcessHeap& operator=(const ProcessHeap&) = delete;
+
+        u8* allocate(usize size) { return m_allocator.allocate(size); }
+        void deallocate(u8 *pointer) { m_allocator.deallocate(pointer); }
+        u8* reallocate(u8 *pointer, usize size) { return m_allocator.reallocate(pointer, size); }
+        bool try_reallocate_in_place(u8 *pointer, usize size) { return m_allocator.try_reallocate_in_place(pointer, size); }
+
+        // The destructor of the object is never called
+        template<typename T, typename... Parameters>
+        T& construct(Parameters&&... parameters)
+        {
+            static_assert(alignof(T) <= sizeof(usize));
+            return *new (allocate(sizeof(T))) T { forward<Parameters>(parameters)... };
+        }
+
+        usize heap_size() const { return m_allocator.heap_size(); }
+
+    private:
+        OwnedPageRange m_range;
+        CachingAllocator<MemoryAllocator, InterruptGuard> m_allocator;
+    };
+
+    // Lets containers of a process draw from its heap.
+    using ProcessAllocator = PoolAllocator<ProcessHeap>;
+}
@@ -42,11 +42,49 @@ namespace Kernel
                         | 1 << M0PLUS_SYST_CSR_ENABLE_LSB;
     }
 
+    void Scheduler::add_thread(RefPtr<Thread> thread)
+    {
+        // Besides the new thread, the active thread and the default thread may be queued by 'schedule'
+        constexpr usize reserved_count = 3;
+
+        for (;;) {
+            usize needed_capacity;
+            {
+                InterruptGuard guard;
+
+                if (m_queued_threads.capacity() >= m_queued_threads.size() + reserved_count) {
+                    m_queued_threads.enqueue(move(thread));
+                    return;
+                }
+
+                needed_capacity = m_queued_threads.size() + reserved_count;
+            }
+
+            // Allocating may lock a mutex, thus the new queue is allocated with interrupts enabled and 'schedule' must
+            // never see a queue that is being moved.  The old storage is freed after the guard is released.
+            GrowableCircularQueue<RefPtr<Thread>> queue;
+            queue.ensure_capacity(needed_capacity);
+            {
+                InterruptGuard guard;
+
+                // Otherwise, further threads were added in the meantime and this is tried again
+                if (queue.capacity() >= m_queued_threads.size() + reserved_count) {
+                    while (m_queued_threads.size() > 0)
+                        queue.enqueue(m_queued_threads.dequeue());
+
+                    swap(queue, m_queued_threads);
+                }
+            }
+        }
+    }
+
     Thread& Scheduler::schedule()
     {
         VERIFY(is_executing_in_handler_mode());
 
         if (!m_active_thread->m_die_at_next_opportunity) {
+            // There is always room, see 'add_thread'
+            VERIFY(m_queued_threads.size() < m_queued_threads.capacity());
             m_queued_threads.enqueue(m_active_thread);
             m_active_thread = nullptr;
         } else {
@@ -29,17 +29,16 @@ namespace Kernel
 
         Thread& schedule();
 
-        void add_thread(RefPtr<Thread> thread)
-        {
-            m_queued_threads.enqueue(thread);
-        }
+        // Must be called once for every new thread, this is the only place where the queue grows.  Blocked threads
+        // stay in the queue, thus waking them up does not have to add them again.
+        void add_thread(RefPtr<Thread> thread);
 
         void loop();
         void trigger();
 
         bool m_enabled = false;
 
-        CircularQueue<RefPtr<Thread>, 16> m_queued_threads;
+        GrowableCircularQueue<RefPtr<Thread>> m_queued_threads;
 
     private:
         RefPtr<Thread> m_default_thread;
@@ -1,3 +1,4 @@
+#include <Std/Arena.hpp>
 #include <Kernel/Threads/Thread.hpp>
 #include <Kernel/Threads/Scheduler.hpp>
 #include <Kernel/Interface/System.hpp>
@@ -78,8 +79,9 @@ namespace Kernel
     {
         VERIFY(&Scheduler::the().active() != this);
 
+        // The thread is still queued, 'schedule' skips it while it is blocked.  Thus this never allocates and can
+        // be used in handler mode.
         m_blocked = false;
-        Scheduler::the().add_thread(*this);
     }
 
     Thread& Thread::active()
@@ -172,7 +174,7 @@ namespace Kernel
                 auto& new_file = *new Kernel::MemoryFile;
                 dynamic_cast<Kernel::VirtualDirectory*>(parent_opt.value())->m_entries.set(path.filename(), &new_file);
 
-                auto& new_handle = new_file.create_handle();
+                auto& new_handle = new_file.create_handle(&m_process->m_heap);
                 return m_process->add_file_handle(new_handle);
             }
 
@@ -199,7 +201,7 @@ namespace Kernel
             file->truncate();
         }
 
-        auto& handle = file->create_handle();
+        auto& handle = file->create_handle(&m_process->m_heap);
         return m_process->add_file_handle(handle);
     }
 
@@ -237,7 +239,7 @@ namespace Kernel
 
     i32 Thread::sys$get_working_directory(u8 *buffer, usize *buffer_size)
     {
-        auto string = m_process->m_working_directory.string();
+        StringView string = m_process->m_working_directory.view();
 
         if (string.size() + 1 > *buffer_size) {
             *buffer_size = string.size() + 1;
@@ -249,6 +251,26 @@ namespace Kernel
         }
     }
 
+    // The debugger loads the symbols of an executable from this path
+    static const char* host_path_of_executable(StringView path)
+    {
+        static constexpr struct {
+            const char *m_system_path;
+            const char *m_host_path;
+        } executables[] {
+            { "/bin/Shell.elf", "Userland/Shell.1.elf" },
+            { "/bin/Example.elf", "Userland/Example.1.elf" },
+            { "/bin/Editor.elf", "Userland/Editor.1.elf" },
+        };
+
+        for (auto& executable : executables) {
+            if (path == executable.m_system_path)
+                return executable.m_host_path;
+        }
+
+        VERIFY_NOT_REACHED();
+    }
+
     i32 Thread::sys$posix_spawn(
         i32 *pid,
         const char *pathname,
@@ -260,36 +282,34 @@ namespace Kernel
         FIXME_ASSERT(file_actions == nullptr);
         FIXME_ASSERT(attrp == nullptr);
 
-        dbgln("sys$posix_spawn(%p, %s, %p, %p, %p, %p)", pid, pathname, file_actions, attrp, argv, envp);
+        dbgln("sys$posix_spawn({}, {}, {}, {}, {}, {})", pid, pathname, file_actions, attrp, argv, envp);
+
+        // Everything built up here dies with this system call, 'Process::create' copies what it keeps
+        Arena arena;
 
-        Vector<String> arguments;
+        Vector<StringView, 0, ArenaAllocator> arguments { arena };
         while (*argv != nullptr)
             arguments.append(*argv++);
 
-        Vector<String> environment;
+        Vector<StringView, 0, ArenaAllocator> environment { arena };
         while (*envp != nullptr)
-            arguments.append(*envp++);
+            environment.append(*envp++);
 
         Path path { pathname };
 
         if (!path.is_absolute())
             path = m_process->m_working_directory / path;
 
-        HashMap<String, String> system_to_host;
-        system_to_host.set("/bin/Shell.elf", "Userland/Shell.1.elf");
-        system_to_host.set("/bin/Example.elf", "Userland/Example.1.elf");
-        system_to_host.set("/bin/Editor.elf", "Userland/Editor.1.elf");
-
         auto& file = dynamic_cast<FlashFile&>(FileSystem::lookup(path));
-        ElfWrapper elf { file.m_data.data(), system_to_host.get_opt(path.string()).must() };
+        ElfWrapper elf { file.m_data.data(), host_path_of_executable(path.view()) };
 
-        auto& new_process = Kernel::Process::create(pathname, move(elf), arguments, environment);
-        new_process.m_parent = m_process;
-        new_process.m_working_directory = m_process->m_working_directory;
+        auto new_process = Kernel::Process::create(pathname, move(elf), arguments.span(), environment.span());
+        new_process->m_parent = m_process;
+        new_process->m_working_directory = m_process->m_working_directory;
 
-        dbgln("[Process::sys$posix_spawn] Created new process PID {} running {}", new_process.m_process_id, path);
+        dbgln("[Process::sys$posix_spawn] Created new process PID {} running {}", new_process->m_process_id, path);
 
-        *pid = new_process.m_process_id;
+        *pid = new_process->m_process_id;
         return 0;
     }
 
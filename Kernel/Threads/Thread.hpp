@@ -5,6 +5,7 @@
 #include <Std/RefPtr.hpp>
 
 #include <Kernel/Forward.hpp>
+#include <Kernel/GlobalMemoryAllocator.hpp>
 #include <Kernel/PageAllocator.hpp>
 #include <Kernel/SystemHandler.hpp>
 #include <Kernel/MPU.hpp>
@@ -29,10 +30,15 @@ namespace Kernel
         Vector<MPU::Region> m_regions;
         Vector<OwnedPageRange> m_owned_page_ranges;
 
+        // Small blocks that were freed by this thread, they are reused without locking the heap
+        AllocationCache m_allocation_cache;
+
         ~Thread()
         {
             if (debug_thread)
                 dbgln("[Thread::~Thread] m_name='{}'", m_name);
+
+            GlobalMemoryAllocator::the().flush(m_allocation_cache);
         }
 
         static Thread& active();
@@ -1,5 +1,6 @@
 #include <Std/Forward.hpp>
 #include <Std/Format.hpp>
+#include <Std/Atom.hpp>
 
 #include <Kernel/Loader.hpp>
 #include <Kernel/ConsoleDevice.hpp>
@@ -12,6 +13,7 @@
 #include <Kernel/ConsoleDevice.hpp>
 #include <Kernel/Interrupt/UART.hpp>
 #include <Kernel/PageAllocator.hpp>
+#include <Kernel/KernelLog.hpp>
 
 #include <hardware/structs/mpu.h>
 
@@ -29,6 +31,46 @@ namespace Kernel
         Kernel::Process::create("/bin/Shell.elf", move(elf));
     }
 
+#if defined(KERNEL_PROCESS_SOAK_TEST)
+    // Every process must give back all of its memory when it dies
+    void run_process_soak_test()
+    {
+        constexpr usize iterations = 500;
+
+        auto& example_file = dynamic_cast<Kernel::FlashFile&>(Kernel::FileSystem::lookup("/bin/Example.elf"));
+
+        auto spawn_and_wait = [&] {
+            Kernel::ElfWrapper elf { example_file.m_data.data(), "Userland/Example.1.elf" };
+            auto process = Kernel::Process::create("/bin/Example.elf", move(elf));
+
+            // The thread of the process holds the other reference
+            while (process->refcount() > 1)
+                Kernel::Scheduler::the().trigger();
+        };
+
+        auto& allocator = Kernel::GlobalMemoryAllocator::the();
+
+        // Anything that is created lazily on first use should not count as leaked
+        spawn_and_wait();
+
+        allocator.flush(Kernel::Thread::active().m_allocation_cache);
+        auto before = allocator.statistics();
+        usize heap_size_before = allocator.heap_size();
+
+        for (usize iteration = 0; iteration < iterations; ++iteration)
+            spawn_and_wait();
+
+        allocator.flush(Kernel::Thread::active().m_allocation_cache);
+        auto after = allocator.statistics();
+
+        dbgln("[main] Soak test: {} processes, heap {} -> {} bytes, {} -> {} bytes available",
+            iterations, heap_size_before, allocator.heap_size(), before.m_avaliable_memory, after.m_avaliable_memory);
+
+        VERIFY(allocator.heap_size() == heap_size_before);
+        VERIFY(after.m_avaliable_memory >= before.m_avaliable_memory);
+    }
+#endif
+
     void boot_with_scheduler();
 
     // Setup basic systems and run 'boot_with_scheduler' in a new thread
@@ -39,10 +81,16 @@ namespace Kernel
 
         Kernel::Interrupt::UART::initialize();
         Kernel::ConsoleFile::initialize();
+        Kernel::KernelLog::initialize();
+
+#if defined(KERNEL_HEAP_TRACE)
+        Kernel::GlobalMemoryAllocator::the().start_trace();
+#endif
 
         dbgln("\e[0;1mBOOT\e[0m");
 
         Kernel::Scheduler::initialize();
+        Kernel::KernelLog::the().start_drain_thread();
 
         auto thread = Kernel::Thread::construct("Kernel (boot_with_scheduler)");
         thread->setup_context(boot_with_scheduler);
@@ -66,6 +114,17 @@ namespace Kernel
         auto& root_file = Kernel::FileSystem::lookup("/");
         dynamic_cast<Kernel::VirtualDirectory&>(root_file).m_entries.set("example.txt", &example_file);
 
+        auto heap_stats = Kernel::GlobalMemoryAllocator::the().statistics();
+        auto atom_stats = Std::Atom::statistics();
+        dbgln("[main] Heap: {} bytes available, largest block {} bytes",
+            heap_stats.m_avaliable_memory, heap_stats.m_largest_continous_block);
+        dbgln("[main] Atoms: {} names with {} references using {} bytes, saved {} bytes of duplicate names",
+            atom_stats.m_atom_count, atom_stats.m_reference_count, atom_stats.m_string_bytes, atom_stats.m_duplicate_bytes);
+
+#if defined(KERNEL_PROCESS_SOAK_TEST)
+        run_process_soak_test();
+#endif
+
         create_shell_process();
     }
 }
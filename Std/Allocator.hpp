@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Std/Forward.hpp>
+
+namespace Std
+{
+    // Containers obtain their memory through an allocator, the size of a block is passed back on every call since
+    // not every allocator can look it up.  Allocators that do not compare equal can not take over each others
+    // blocks.
+    //
+    // By default, memory comes from the global heap.
+    struct HeapAllocator {
+        void* allocate(usize size) { return malloc(size); }
+        void deallocate(void *pointer, usize) { free(pointer); }
+
+        void* reallocate(void *pointer, usize, usize new_size) { return realloc(pointer, new_size); }
+        bool try_reallocate_in_place(void *pointer, usize, usize new_size) { return try_realloc_in_place(pointer, new_size); }
+
+        bool operator==(const HeapAllocator&) const { return true; }
+    };
+
+    // Draws from a dedicated 'MemoryAllocator' or 'TlsfAllocator' instead of the global heap, e.g. a pool that is
+    // dropped as a whole.
+    template<typename Backend>
+    class PoolAllocator {
+    public:
+        PoolAllocator(Backend& backend)
+            : m_backend(&backend)
+        {
+        }
+
+        void* allocate(usize size) { return m_backend->allocate(size); }
+        void deallocate(void *pointer, usize) { m_backend->deallocate(reinterpret_cast<u8*>(pointer)); }
+
+        void* reallocate(void *pointer, usize, usize new_size) { return m_backend->reallocate(reinterpret_cast<u8*>(pointer), new_size); }
+        bool try_reallocate_in_place(void *pointer, usize, usize new_size)
+        {
+            return pointer != nullptr && m_backend->try_reallocate_in_place(reinterpret_cast<u8*>(pointer), new_size);
+        }
+
+        bool operator==(const PoolAllocator& other) const { return m_backend == other.m_backend; }
+
+    private:
+        Backend *m_backend;
+    };
+}
@@ -0,0 +1,111 @@
+#include <Std/Arena.hpp>
+
+#if defined(TEST)
+# include <cstdlib>
+#elif defined(KERNEL)
+# include <Kernel/PageAllocator.hpp>
+#endif
+
+namespace Std
+{
+    Arena::Chunk* Arena::allocate_chunk(usize power)
+    {
+#if defined(TEST)
+        void *memory = aligned_alloc(usize(1) << power, usize(1) << power);
+        VERIFY(memory != nullptr);
+#elif defined(KERNEL)
+        auto range = Kernel::PageAllocator::the().allocate(power).must();
+
+        // The range is handed back in 'deallocate_chunk'
+        void *memory = range.data();
+        range.m_range.clear();
+#endif
+
+        auto *chunk = reinterpret_cast<Chunk*>(memory);
+        chunk->m_power = power;
+
+        return chunk;
+    }
+
+    void Arena::deallocate_chunk(Chunk *chunk)
+    {
+#if defined(TEST)
+        ::free(chunk);
+#elif defined(KERNEL)
+        Kernel::OwnedPageRange range { Kernel::PageRange { chunk->m_power, uptr(chunk) } };
+#endif
+    }
+
+    u8* Arena::allocate(usize size, usize alignment)
+    {
+        VERIFY(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+        u8 *pointer = reinterpret_cast<u8*>((uptr(m_top) + alignment - 1) & ~(alignment - 1));
+
+        if (m_chunk == nullptr || pointer + size > m_end) {
+            // Large allocations get a chunk of their own
+            usize power = m_chunk_power;
+            while ((usize(1) << power) < sizeof(Chunk) + alignment + size)
+                ++power;
+
+            Chunk *chunk = allocate_chunk(power);
+            chunk->m_previous = m_chunk;
+
+            m_chunk = chunk;
+            m_end = reinterpret_cast<u8*>(chunk) + (usize(1) << power);
+
+            pointer = reinterpret_cast<u8*>((uptr(chunk + 1) + alignment - 1) & ~(alignment - 1));
+        }
+
+        m_top = pointer + size;
+        return pointer;
+    }
+
+    bool Arena::try_reallocate_in_place(u8 *pointer, usize old_size, usize new_size)
+    {
+        if (new_size <= old_size) {
+            if (pointer + old_size == m_top)
+                m_top = pointer + new_size;
+
+            return true;
+        }
+
+        if (pointer + old_size != m_top || pointer + new_size > m_end)
+            return false;
+
+        m_top = pointer + new_size;
+        return true;
+    }
+
+    void Arena::deallocate(u8 *pointer, usize size)
+    {
+        if (pointer != nullptr && pointer + size == m_top)
+            m_top = pointer;
+    }
+
+    StringView Arena::copy(StringView string)
+    {
+        char *data = allocate_array<char>(string.size() + 1);
+        string.strcpy_to({ data, string.size() + 1 });
+
+        return { data, string.size() };
+    }
+
+    void Arena::clear()
+    {
+        while (m_chunk != nullptr)
+            deallocate_chunk(exchange(m_chunk, m_chunk->m_previous));
+
+        m_top = nullptr;
+        m_end = nullptr;
+    }
+
+    usize Arena::chunk_count() const
+    {
+        usize count = 0;
+        for (Chunk *chunk = m_chunk; chunk; chunk = chunk->m_previous)
+            ++count;
+
+        return count;
+    }
+}
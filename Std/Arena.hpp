@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Std/Allocator.hpp>
+#include <Std/StringView.hpp>
+
+namespace Std
+{
+    // Allocations are bumped out of chunks and are only released all at once, when the arena is cleared or
+    // destroyed.  This is meant for temporary objects that die together, for example everything a system call
+    // builds up, without fragmenting the global heap.
+    //
+    // In the kernel, the chunks are obtained from the page allocator.
+    class Arena {
+    public:
+        static constexpr usize default_chunk_power = 10;
+
+        explicit Arena(usize chunk_power = default_chunk_power)
+            : m_chunk_power(chunk_power)
+        {
+        }
+        Arena(const Arena&) = delete;
+        Arena(Arena&& other)
+            : m_chunk(exchange(other.m_chunk, nullptr))
+            , m_top(exchange(other.m_top, nullptr))
+            , m_end(exchange(other.m_end, nullptr))
+            , m_chunk_power(other.m_chunk_power)
+        {
+        }
+        ~Arena()
+        {
+            clear();
+        }
+
+        Arena& operator=(const Arena&) = delete;
+        Arena& operator=(Arena&&) = delete;
+
+        u8* allocate(usize size, usize alignment = sizeof(usize));
+
+        // Only the most recent allocation can be resized or given back, any other call does nothing.
+        bool try_reallocate_in_place(u8*, usize old_size, usize new_size);
+        void deallocate(u8*, usize size);
+
+        template<typename T>
+        T* allocate_array(usize count)
+        {
+            return reinterpret_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+        }
+
+        // The copy is null terminated, thus its data can be used as a C string.
+        StringView copy(StringView);
+
+        // Releases all chunks, every pointer into this arena becomes invalid.
+        void clear();
+
+        // Number of chunks that are currently held.
+        usize chunk_count() const;
+
+    private:
+        struct Chunk {
+            Chunk *m_previous;
+            usize m_power;
+        };
+
+        static Chunk* allocate_chunk(usize power);
+        static void deallocate_chunk(Chunk*);
+
+        Chunk *m_chunk = nullptr;
+        u8 *m_top = nullptr;
+        u8 *m_end = nullptr;
+
+        usize m_chunk_power;
+    };
+
+    // Lets containers draw from an arena, freed blocks are only reclaimed if they were the last allocation.
+    class ArenaAllocator {
+    public:
+        ArenaAllocator(Arena& arena)
+            : m_arena(&arena)
+        {
+        }
+
+        void* allocate(usize size) { return m_arena->allocate(size); }
+        void deallocate(void *pointer, usize size) { m_arena->deallocate(reinterpret_cast<u8*>(pointer), size); }
+
+        void* reallocate(void *pointer, usize old_size, usize new_size)
+        {
+            if (pointer == nullptr)
+                return allocate(new_size);
+
+            if (try_reallocate_in_place(pointer, old_size, new_size))
+                return pointer;
+
+            void *new_pointer = allocate(new_size);
+            memcpy(new_pointer, pointer, min(old_size, new_size));
+
+            return new_pointer;
+        }
+        bool try_reallocate_in_place(void *pointer, usize old_size, usize new_size)
+        {
+            return m_arena->try_reallocate_in_place(reinterpret_cast<u8*>(pointer), old_size, new_size);
+        }
+
+        bool operator==(const ArenaAllocator& other) const { return m_arena == other.m_arena; }
+
+    private:
+        Arena *m_arena;
+    };
+}
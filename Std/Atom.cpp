@@ -0,0 +1,142 @@
+#include <Std/Atom.hpp>
+#include <Std/HashTable.hpp>
+
+#if defined(TEST)
+# include <mutex>
+#elif defined(KERNEL)
+# include <Kernel/HandlerMode.hpp>
+#endif
+
+namespace Std
+{
+    struct AtomTableEntry {
+        Atom::Impl *m_impl;
+
+        StringView view() const { return { m_impl->m_data, m_impl->m_size }; }
+
+        u32 hash() const { return m_impl->m_hash; }
+
+        bool operator==(const AtomTableEntry& other) const { return m_impl == other.m_impl; }
+        bool operator==(StringView other) const { return view() == other; }
+
+        static Optional<Atom> lookup(StringView);
+        static Atom create(StringView);
+    };
+
+#if defined(TEST)
+    // Stands in for masking interrupts, it can be nested the same way
+    struct AtomTableGuard {
+        AtomTableGuard() { mutex.lock(); }
+        ~AtomTableGuard() { mutex.unlock(); }
+
+        static inline std::recursive_mutex mutex;
+    };
+#elif defined(KERNEL)
+    using AtomTableGuard = Kernel::InterruptGuard;
+#endif
+
+    // Only accessed while holding an 'AtomTableGuard', the strings are allocated and freed outside of it.
+    static HashTable<AtomTableEntry> table;
+
+    Optional<Atom> AtomTableEntry::lookup(StringView string)
+    {
+        AtomTableGuard guard;
+
+        AtomTableEntry *entry = table.search(string);
+
+        if (entry)
+            return Atom { entry->m_impl };
+        else
+            return {};
+    }
+
+    Atom AtomTableEntry::create(StringView string)
+    {
+        auto atom_opt = lookup(string);
+        if (atom_opt.is_valid())
+            return move(atom_opt.value());
+
+        // The string is stored in the same allocation, directly after the header
+        auto *impl = reinterpret_cast<Atom::Impl*>(new u8[sizeof(Atom::Impl) + string.size() + 1]);
+        impl->m_refcount = 0;
+        impl->m_hash = Hash<StringView>::compute(string);
+        impl->m_size = string.size();
+        string.strcpy_to({ impl->m_data, string.size() + 1 });
+
+        Atom atom;
+        {
+            AtomTableGuard guard;
+
+            // Another thread may have interned the same string in the meantime
+            if (AtomTableEntry *entry = table.search(string)) {
+                atom = Atom { entry->m_impl };
+            } else {
+                table.insert({ impl });
+                atom = Atom { exchange(impl, nullptr) };
+            }
+        }
+
+        delete[] reinterpret_cast<u8*>(impl);
+        return atom;
+    }
+
+    Atom::Atom(StringView string)
+        : Atom(AtomTableEntry::create(string))
+    {
+    }
+
+    Optional<Atom> Atom::lookup(StringView string)
+    {
+        return AtomTableEntry::lookup(string);
+    }
+
+    void Atom::ref()
+    {
+        if (m_impl == nullptr)
+            return;
+
+        AtomTableGuard guard;
+        ++m_impl->m_refcount;
+    }
+
+    void Atom::unref()
+    {
+        if (m_impl == nullptr)
+            return;
+
+        Impl *impl = exchange(m_impl, nullptr);
+        {
+            AtomTableGuard guard;
+
+            VERIFY(impl->m_refcount > 0);
+            if (--impl->m_refcount > 0)
+                return;
+
+            table.remove(AtomTableEntry { impl });
+        }
+
+        delete[] reinterpret_cast<u8*>(impl);
+    }
+
+    Atom::Statistics Atom::statistics()
+    {
+        AtomTableGuard guard;
+
+        Statistics stats;
+
+        stats.m_atom_count = table.size();
+        stats.m_reference_count = 0;
+        stats.m_string_bytes = 0;
+        stats.m_duplicate_bytes = 0;
+
+        for (auto& entry : table.iter()) {
+            usize string_bytes = entry.m_impl->m_size + 1;
+
+            stats.m_reference_count += entry.m_impl->m_refcount;
+            stats.m_string_bytes += string_bytes;
+            stats.m_duplicate_bytes += (entry.m_impl->m_refcount - 1) * string_bytes;
+        }
+
+        return stats;
+    }
+}
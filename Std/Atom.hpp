@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Std/Forward.hpp>
+#include <Std/StringView.hpp>
+#include <Std/Optional.hpp>
+#include <Std/Format.hpp>
+
+namespace Std
+{
+    // An interned, immutable string.  Each distinct string is stored exactly once together with its hash,
+    // atoms are compared by pointer.  The storage is released when the last reference goes away.
+    //
+    // The atom table and the reference counts are accessed with interrupts masked, thus atoms can be shared
+    // between threads and copied or dropped in handler mode.
+    class Atom {
+    public:
+        Atom()
+            : m_impl(nullptr)
+        {
+        }
+        Atom(StringView);
+        Atom(const char *string)
+            : Atom(StringView { string })
+        {
+        }
+        Atom(const String& string)
+            : Atom(string.view())
+        {
+        }
+        Atom(const Atom& other)
+            : m_impl(other.m_impl)
+        {
+            ref();
+        }
+        Atom(Atom&& other)
+            : m_impl(exchange(other.m_impl, nullptr))
+        {
+        }
+        ~Atom()
+        {
+            unref();
+        }
+
+        // Returns the atom if the string was interned already, never creates a new atom.
+        static Optional<Atom> lookup(StringView);
+
+        bool is_null() const { return m_impl == nullptr; }
+
+        StringView view() const
+        {
+            if (m_impl == nullptr)
+                return {};
+
+            return { m_impl->m_data, m_impl->m_size };
+        }
+        operator StringView() const { return view(); }
+
+        void strcpy_to(Span<char> other) const
+        {
+            return view().strcpy_to(other);
+        }
+
+        u32 hash() const
+        {
+            if (m_impl == nullptr)
+                return Hash<StringView>::compute({});
+
+            return m_impl->m_hash;
+        }
+
+        Atom& operator=(const Atom& other)
+        {
+            if (m_impl != other.m_impl) {
+                unref();
+                m_impl = other.m_impl;
+                ref();
+            }
+
+            return *this;
+        }
+        Atom& operator=(Atom&& other)
+        {
+            if (this != &other) {
+                unref();
+                m_impl = exchange(other.m_impl, nullptr);
+            }
+
+            return *this;
+        }
+
+        bool operator==(const Atom& other) const { return m_impl == other.m_impl; }
+        bool operator==(StringView other) const { return view() == other; }
+
+        struct Statistics {
+            usize m_atom_count;
+            usize m_reference_count;
+
+            // Bytes used to store the strings of all atoms
+            usize m_string_bytes;
+
+            // Bytes that would have been needed if each reference owned a copy of the string
+            usize m_duplicate_bytes;
+        };
+
+        static Statistics statistics();
+
+    private:
+        struct Impl {
+            usize m_refcount;
+            u32 m_hash;
+            usize m_size;
+            char m_data[];
+        };
+
+        friend struct AtomTableEntry;
+
+        explicit Atom(Impl *impl)
+            : m_impl(impl)
+        {
+            ref();
+        }
+
+        void ref();
+        void unref();
+
+        Impl *m_impl;
+    };
+
+    template<>
+    struct IsTriviallyRelocatable<Atom> : IntegralConstant<bool, true> {
+    };
+
+    template<>
+    struct Formatter<Atom> {
+        static void format(StringBuilder& builder, const Atom& value)
+        {
+            Formatter<StringView>::format(builder, value.view());
+        }
+    };
+}
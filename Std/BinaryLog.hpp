@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Std/Format.hpp>
+#include <Std/Vector.hpp>
+
+#include <Kernel/Interface/BinaryLog.hpp>
+
+namespace Std
+{
+    // Builds a record as described in 'Kernel/Interface/BinaryLog.hpp'.
+    class BinaryLogEncoder {
+    public:
+        explicit BinaryLogEncoder(const char *string)
+        {
+            Kernel::BinaryLog::RecordHeader header;
+            header.m_magic[0] = Kernel::BinaryLog::magic[0];
+            header.m_magic[1] = Kernel::BinaryLog::magic[1];
+            header.m_size = 0;
+            header.m_string_address = u32(uptr(string));
+
+            append_raw(&header, sizeof(header));
+        }
+
+        template<typename T>
+        void encode(const T& value)
+        {
+            using Kernel::BinaryLog::Tag;
+
+            if constexpr (Concepts::Integral<T>) {
+                constexpr bool is_signed = T(-1) < T(0);
+
+                append_tag(is_signed ? Tag::Signed : Tag::Unsigned, sizeof(T));
+                append_raw(&value, sizeof(T));
+            } else if constexpr (Concepts::Same<T, char>) {
+                append_tag(Tag::Char, 1);
+                append_raw(&value, 1);
+            } else if constexpr (Concepts::Same<T, bool>) {
+                append_tag(Tag::Bool, 1);
+                m_data.append(value ? 1 : 0);
+            } else if constexpr (requires { static_cast<const void*>(value); } && !requires { StringView { value }; }) {
+                const void *pointer = value;
+                append_tag(Tag::Pointer, sizeof(pointer));
+                append_raw(&pointer, sizeof(pointer));
+            } else if constexpr (requires { StringView { value }; }) {
+                append_string(StringView { value });
+            } else {
+                StringBuilder builder;
+                Formatter<T>::format(builder, value);
+                append_string(builder.view());
+            }
+        }
+
+        // Fills in the size of the arguments, no more arguments can be added afterwards.
+        ReadonlyBytes finalize()
+        {
+            u16 size = u16(m_data.size() - sizeof(Kernel::BinaryLog::RecordHeader));
+            memcpy(m_data.data() + __builtin_offsetof(Kernel::BinaryLog::RecordHeader, m_size), &size, sizeof(size));
+
+            return { m_data.data(), m_data.size() };
+        }
+
+    private:
+        void append_tag(Kernel::BinaryLog::Tag tag, usize size)
+        {
+            m_data.append(u8(tag) | u8(size));
+        }
+
+        void append_string(StringView value)
+        {
+            u16 size = u16(min<usize>(value.size(), 0xffff));
+
+            append_tag(Kernel::BinaryLog::Tag::String, 0);
+            append_raw(&size, sizeof(size));
+            append_raw(value.data(), size);
+        }
+
+        // The kernel runs in little endian, the values are copied as they are
+        void append_raw(const void *data, usize size)
+        {
+            m_data.extend({ reinterpret_cast<const u8*>(data), size });
+        }
+
+        Vector<u8, 64> m_data;
+    };
+
+    void dbgln_binary_raw(ReadonlyBytes);
+
+    // The format string is only passed to validate it at compile time, 'string' is the copy that is referenced by
+    // the record.
+    template<typename... Parameters>
+    void dbgln_binary(const char *string, FormatString<typename TypeIdentity<Parameters>::Type...>, const Parameters&... parameters)
+    {
+        BinaryLogEncoder encoder { string };
+        (encoder.encode(parameters), ...);
+        dbgln_binary_raw(encoder.finalize());
+    }
+}
+
+// Each call site places its format string in the '.kernel_log_strings' section, the linker script for this mode
+// does not load that section and places it at address zero.  The lambda must not be generic, otherwise GCC drops
+// the section attribute.
+#define dbgln(fmtstr, ...)                                                                                      \
+    ::Std::dbgln_binary(                                                                                       \
+        [] {                                                                                                   \
+            [[gnu::section(".kernel_log_strings")]] static const char string[] = fmtstr;                      \
+            return string;                                                                                     \
+        }(),                                                                                                   \
+        fmtstr __VA_OPT__(,) __VA_ARGS__)
@@ -0,0 +1,444 @@
+#pragma once
+
+#include <Std/Span.hpp>
+#include <Std/HeapTrace.hpp>
+
+namespace Std
+{
+    // The blocks of 'MemoryAllocator' and 'TlsfAllocator', these only differ in how they find free blocks.
+    //
+    // Blocks carry boundary tags: the size in a header word before the data and, if the block is free, again in
+    // a footer in its last word.  Thus the neighbours of a block are found without searching and freed blocks are
+    // merged with them in constant time.
+    //
+    // The heap can grow by adding further regions of memory, each of them ends in a sentinel of its own.
+    //
+    // 'Derived' keeps the free blocks in an index of its own and provides 'link_free_block', 'unlink_free_block',
+    // 'try_allocate', 'try_reallocate_in_place', 'usable_size', 'deallocate_block', 'check_free_blocks',
+    // 'free_block_size_for' and 'max_block_size'.
+    template<typename Derived>
+    class BoundaryTagAllocator {
+    public:
+        // The index of 'Derived' is not initialized yet, its constructor must call 'free_initial_block'.
+        explicit BoundaryTagAllocator(Bytes heap)
+        {
+            // Both ends of the heap are aligned, the footers and the sentinel are accessed as words
+            usize padding = round_up(uptr(heap.data())) - uptr(heap.data());
+            VERIFY(heap.size() >= padding + min_block_size + header_size);
+
+            m_heap = { heap.data() + padding, (heap.size() - padding) & ~(alignment - 1) };
+
+            usize size = m_heap.size() - header_size;
+            VERIFY(size <= Derived::max_block_size);
+
+            m_sentinel = reinterpret_cast<Node*>(m_heap.data() + size);
+            m_sentinel->m_size = 0;
+        }
+
+        usize heap_size() const { return m_heap.size() + m_region_bytes; }
+
+        // Adds memory to the heap, blocks are never merged across regions.
+        void add_region(Bytes bytes)
+        {
+            VERIFY(bytes.size() >= alignment + sizeof(Region) + min_block_size);
+
+            u8 *begin = reinterpret_cast<u8*>(round_up(uptr(bytes.data())));
+            u8 *end = reinterpret_cast<u8*>((uptr(bytes.data()) + bytes.size() - sizeof(Region)) & ~(alignment - 1));
+            VERIFY(end >= begin + min_block_size);
+            VERIFY(usize(end - begin) <= Derived::max_block_size);
+
+            auto *region = reinterpret_cast<Region*>(end);
+            region->m_sentinel = 0;
+            region->m_begin = begin;
+            region->m_bytes = bytes;
+
+            region->m_previous = nullptr;
+            region->m_next = m_regions;
+            if (m_regions != nullptr)
+                m_regions->m_previous = region;
+            m_regions = region;
+
+            m_region_bytes += bytes.size();
+
+            // The first block of a region has no previous block, thus 'previous_free_flag' is never set
+            make_free_block(reinterpret_cast<Node*>(begin), usize(end - begin));
+        }
+
+        // If a region that was added with 'add_region' became entirely free, it is removed from the heap and
+        // returned.  Otherwise, this returns an empty span without searching.
+        Bytes take_free_region()
+        {
+            if (!m_has_free_region)
+                return {};
+
+            for (Region *region = m_regions; region; region = region->m_next) {
+                Node *node = reinterpret_cast<Node*>(region->m_begin);
+                if (!is_free(node) || next_block(node) != reinterpret_cast<Node*>(&region->m_sentinel))
+                    continue;
+
+                derived().unlink_free_block(node);
+
+                if (region->m_previous != nullptr)
+                    region->m_previous->m_next = region->m_next;
+                else
+                    m_regions = region->m_next;
+                if (region->m_next != nullptr)
+                    region->m_next->m_previous = region->m_previous;
+
+                m_region_bytes -= region->m_bytes.size();
+
+                // Further regions may be free as well, the flag stays set
+                return region->m_bytes;
+            }
+
+            m_has_free_region = false;
+            return {};
+        }
+
+        // A region of this many bytes can serve an allocation of 'size' bytes.
+        static usize region_size_for(usize size)
+        {
+            usize needed = Derived::free_block_size_for(block_size_for(size));
+
+            // Both ends of the region may have to be aligned
+            return needed + sizeof(Region) + 2 * alignment;
+        }
+
+        // Calls 'callback' with the initial heap and every region that was added with 'add_region'.
+        template<typename Callback>
+        void for_each_region(Callback&& callback) const
+        {
+            callback(m_heap);
+            for (Region *region = m_regions; region != nullptr; region = region->m_next)
+                callback(region->m_bytes);
+        }
+
+        // Calls 'callback' with the memory of every region that was added with 'add_region', the callback may
+        // release it.  Afterwards, the allocator must not be used anymore.
+        template<typename Callback>
+        void release_regions(Callback&& callback)
+        {
+            while (m_regions != nullptr) {
+                Bytes bytes = m_regions->m_bytes;
+                m_regions = m_regions->m_next;
+
+                callback(bytes);
+            }
+            m_region_bytes = 0;
+        }
+
+        u8* allocate(usize size, bool debug_override = true, void *address = nullptr)
+        {
+            if (address == nullptr)
+                address = __builtin_return_address(0);
+
+            u8 *pointer = derived().try_allocate(size);
+            VERIFY(pointer != nullptr);
+
+            if (m_debug && debug_override)
+                HeapTrace::allocate(address, pointer, size);
+
+            return pointer;
+        }
+        void deallocate(u8 *pointer, bool debug_override = true, void *address = nullptr)
+        {
+            if (pointer == nullptr)
+                return;
+
+            if (address == nullptr)
+                address = __builtin_return_address(0);
+
+            if (m_debug && debug_override)
+                HeapTrace::deallocate(address, pointer);
+
+            derived().deallocate_block(pointer);
+        }
+        u8* reallocate(u8 *pointer, usize size, bool debug_override = true, void *address = nullptr)
+        {
+            if (address == nullptr)
+                address = __builtin_return_address(0);
+
+            if (pointer == nullptr)
+                return allocate(size, debug_override, address);
+
+            // Shrinking always succeeds, growing only if the following block is free and large enough
+            if (derived().try_reallocate_in_place(pointer, size)) {
+                if (m_debug && debug_override)
+                    HeapTrace::reallocate(address, pointer, pointer, size);
+
+                return pointer;
+            }
+
+            u8 *new_pointer = allocate(size, false);
+            memcpy(new_pointer, pointer, Derived::usable_size(pointer));
+            deallocate(pointer, false);
+
+            if (m_debug && debug_override)
+                HeapTrace::reallocate(address, pointer, new_pointer, size);
+
+            return new_pointer;
+        }
+
+        // Walks all blocks and crashes if any invariant is violated, this is slow.
+        void heap_check()
+        {
+            usize free_count = check_blocks(reinterpret_cast<Node*>(m_heap.data()), m_sentinel);
+
+            usize region_bytes = 0;
+            for (Region *region = m_regions; region; region = region->m_next) {
+                VERIFY(region->m_next == nullptr || region->m_next->m_previous == region);
+                free_count += check_blocks(reinterpret_cast<Node*>(region->m_begin), reinterpret_cast<Node*>(&region->m_sentinel));
+
+                region_bytes += region->m_bytes.size();
+            }
+            VERIFY(region_bytes == m_region_bytes);
+
+            derived().check_free_blocks(free_count);
+        }
+
+        struct Statistics {
+            usize m_largest_continous_block;
+            usize m_avaliable_memory;
+
+            // Free slots in slabs that are partially used, these can only be used for small allocations
+            usize m_size_class_memory;
+        };
+
+        bool m_debug = false;
+
+    protected:
+        // 'm_size' is the size of the whole block including this header, the lower bits hold the flags.  The
+        // links are only valid while the block is free, otherwise the data starts there.
+        struct Node {
+            usize m_size;
+            Node *m_next;
+            Node *m_previous;
+        };
+
+        static constexpr usize free_flag = 1 << 0;
+        static constexpr usize previous_free_flag = 1 << 1;
+        static constexpr usize flag_mask = free_flag | previous_free_flag;
+
+        static constexpr usize alignment = sizeof(usize);
+        static constexpr usize header_size = sizeof(usize);
+
+        // A free block must hold the header, the links and the footer
+        static constexpr usize min_block_size = sizeof(Node) + sizeof(usize);
+
+        // Added regions end with this, the first word is the sentinel of the region
+        struct Region {
+            usize m_sentinel;
+
+            Region *m_next;
+            Region *m_previous;
+
+            u8 *m_begin;
+            Bytes m_bytes;
+        };
+
+        static usize block_size(const Node *node) { return node->m_size & ~flag_mask; }
+        static usize usable_size(const Node *node) { return block_size(node) - header_size; }
+        static bool is_free(const Node *node) { return node->m_size & free_flag; }
+
+        static u8* data_of(Node *node) { return reinterpret_cast<u8*>(node) + header_size; }
+        static Node* node_of(u8 *pointer) { return reinterpret_cast<Node*>(pointer - header_size); }
+
+        static Node* next_block(Node *node) { return reinterpret_cast<Node*>(reinterpret_cast<u8*>(node) + block_size(node)); }
+
+        // Only valid if 'previous_free_flag' is set, the footer of the previous block holds its size
+        static Node* previous_block(Node *node)
+        {
+            usize size = *reinterpret_cast<usize*>(reinterpret_cast<u8*>(node) - sizeof(usize));
+            return reinterpret_cast<Node*>(reinterpret_cast<u8*>(node) - size);
+        }
+
+        static usize round_up(usize size) { return (size + alignment - 1) & ~(alignment - 1); }
+
+        // The size of a block that can hold 'size' bytes
+        static usize block_size_for(usize size) { return max(min_block_size, round_up(size + header_size)); }
+
+        // Turns the initial heap into a single free block
+        void free_initial_block()
+        {
+            make_free_block(reinterpret_cast<Node*>(m_heap.data()), m_heap.size() - header_size);
+        }
+
+        // Turns the memory into a single free block and adds it to the index, the neighbours must be in use
+        void make_free_block(Node *node, usize size)
+        {
+            node->m_size = size | free_flag;
+            *reinterpret_cast<usize*>(reinterpret_cast<u8*>(node) + size - sizeof(usize)) = size;
+
+            next_block(node)->m_size |= previous_free_flag;
+
+            derived().link_free_block(node);
+        }
+
+        // Splits 'node' into a block of 'size' bytes in use and a free remainder if that is large enough
+        void split_block(Node *node, usize size)
+        {
+            usize old_size = block_size(node);
+
+            if (old_size - size < min_block_size) {
+                next_block(node)->m_size &= ~previous_free_flag;
+                return;
+            }
+
+            node->m_size = size | (node->m_size & previous_free_flag);
+
+            // The block after the remainder is in use, otherwise it would have been merged with this block
+            make_free_block(next_block(node), old_size - size);
+        }
+
+        // Returns the memory after the first 'size' bytes of the block in use to the index, unless it is too
+        // little to be worth another block
+        void shrink_block(Node *node, usize size)
+        {
+            usize tail = block_size(node) - size;
+            if (tail == 0)
+                return;
+
+            // The tail can always be given to a free neighbour, this does not create another block
+            Node *next = next_block(node);
+            if (is_free(next)) {
+                derived().unlink_free_block(next);
+                tail += block_size(next);
+            } else if (tail < min_block_size || tail < block_size(node) / 4) {
+                return;
+            }
+
+            node->m_size = size | (node->m_size & previous_free_flag);
+            make_free_block(next_block(node), tail);
+        }
+
+        // Takes the free block out of the index and returns the data of a block of 'size' bytes in it
+        u8* allocate_block(Node *node, usize size)
+        {
+            derived().unlink_free_block(node);
+
+            // Free blocks never follow each other, thus the previous block is in use
+            node->m_size = block_size(node);
+            split_block(node, size);
+
+            return data_of(node);
+        }
+
+        // Merges the block in use with its free neighbours and adds the result to the index
+        void free_block(Node *node)
+        {
+            VERIFY(!is_free(node));
+
+            usize size = block_size(node);
+
+            Node *next = next_block(node);
+            if (is_free(next)) {
+                derived().unlink_free_block(next);
+                size += block_size(next);
+            }
+
+            if (node->m_size & previous_free_flag) {
+                Node *previous = previous_block(node);
+                derived().unlink_free_block(previous);
+
+                size += block_size(previous);
+                node = previous;
+            }
+
+            make_free_block(node, size);
+            note_if_region_free(node);
+        }
+
+        // Resizes the block in use to hold 'size' bytes without moving it, growing only works into a following
+        // free block
+        bool try_resize_block(Node *node, usize size)
+        {
+            usize needed = block_size_for(size);
+            if (needed <= block_size(node)) {
+                shrink_block(node, needed);
+                return true;
+            }
+
+            Node *next = next_block(node);
+            if (!is_free(next) || block_size(node) + block_size(next) < needed)
+                return false;
+
+            derived().unlink_free_block(next);
+            node->m_size += block_size(next);
+
+            split_block(node, needed);
+            return true;
+        }
+
+        bool contains(u8 *pointer) const
+        {
+            if (pointer >= m_heap.data() && pointer < reinterpret_cast<u8*>(m_sentinel))
+                return true;
+
+            for (Region *region = m_regions; region; region = region->m_next) {
+                if (pointer >= region->m_begin && pointer < reinterpret_cast<u8*>(region))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // Called with a free block after it was merged with its neighbours
+        void note_if_region_free(Node *node)
+        {
+            Node *next = next_block(node);
+            if (block_size(next) != 0 || next == m_sentinel)
+                return;
+
+            if (reinterpret_cast<Region*>(next)->m_begin == reinterpret_cast<u8*>(node))
+                m_has_free_region = true;
+        }
+
+        // Returns the number of free blocks between 'begin' and 'sentinel'
+        usize check_blocks(Node *begin, Node *sentinel)
+        {
+            usize free_count = 0;
+            bool previous_free = false;
+
+            Node *node = begin;
+            while (node != sentinel) {
+                usize size = block_size(node);
+
+                VERIFY(size >= min_block_size && size % alignment == 0);
+                VERIFY(reinterpret_cast<u8*>(node) + size <= reinterpret_cast<u8*>(sentinel));
+                VERIFY(bool(node->m_size & previous_free_flag) == previous_free);
+
+                if (is_free(node)) {
+                    // Adjacent free blocks must have been merged
+                    VERIFY(!previous_free);
+                    VERIFY(*reinterpret_cast<usize*>(reinterpret_cast<u8*>(node) + size - sizeof(usize)) == size);
+
+                    VERIFY(node->m_next == nullptr || node->m_next->m_previous == node);
+
+                    ++free_count;
+                }
+
+                previous_free = is_free(node);
+                node = next_block(node);
+            }
+
+            VERIFY(block_size(sentinel) == 0 && !is_free(sentinel));
+            VERIFY(bool(sentinel->m_size & previous_free_flag) == previous_free);
+
+            return free_count;
+        }
+
+        Bytes m_heap;
+
+        // The sentinel marks the end of the heap, it is a block in use without data
+        Node *m_sentinel;
+
+        Region *m_regions = nullptr;
+        usize m_region_bytes = 0;
+
+        // Set if a region may be entirely free, cleared once 'take_free_region' finds none
+        bool m_has_free_region = false;
+
+    private:
+        Derived& derived() { return static_cast<Derived&>(*this); }
+    };
+}
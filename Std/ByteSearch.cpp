@@ -0,0 +1,201 @@
+#include <Std/ByteSearch.hpp>
+
+namespace Std
+{
+    using Word = usize;
+
+    // Loads through this type may alias any object
+    typedef usize __attribute__((may_alias)) AliasedWord;
+
+    static constexpr Word low_bits = Word(-1) / 0xff;
+    static constexpr Word high_bits = low_bits * 0x80;
+
+    static inline Word broadcast(char value)
+    {
+        return low_bits * u8(value);
+    }
+
+    // Sets the high bit of every zero byte.  A borrow can flag bytes above the first zero byte as well, but never
+    // below it, thus the lowest flagged byte is always correct.
+    static inline Word zero_bytes(Word word)
+    {
+        return (word - low_bits) & ~word & high_bits;
+    }
+
+    // The device and the host are both little endian, the lowest byte in memory is the least significant one
+    static inline usize lowest_byte(Word mask)
+    {
+        return usize(__builtin_ctzl(mask)) / 8;
+    }
+
+    static inline bool is_aligned(const char *pointer)
+    {
+        return (uptr(pointer) & (sizeof(Word) - 1)) == 0;
+    }
+
+    static inline Word load(const char *pointer)
+    {
+        return *reinterpret_cast<const AliasedWord*>(pointer);
+    }
+
+    Optional<usize> find_byte(const char *data, usize size, char needle)
+    {
+        usize offset = 0;
+
+        for (; offset < size && !is_aligned(data + offset); ++offset) {
+            if (data[offset] == needle)
+                return offset;
+        }
+
+        Word pattern = broadcast(needle);
+        for (; offset + sizeof(Word) <= size; offset += sizeof(Word)) {
+            Word mask = zero_bytes(load(data + offset) ^ pattern);
+
+            if (mask != 0)
+                return offset + lowest_byte(mask);
+        }
+
+        for (; offset < size; ++offset) {
+            if (data[offset] == needle)
+                return offset;
+        }
+
+        return {};
+    }
+
+    // With many needles, checking every needle against every word is slower than a table lookup per byte
+    static Optional<usize> find_any_of_in_table(const char *data, usize size, const char *needles, usize needle_count)
+    {
+        u32 table[256 / 32] = {};
+        for (usize index = 0; index < needle_count; ++index)
+            table[u8(needles[index]) / 32] |= 1u << (u8(needles[index]) % 32);
+
+        for (usize offset = 0; offset < size; ++offset) {
+            u8 value = u8(data[offset]);
+
+            if (table[value / 32] & (1u << (value % 32)))
+                return offset;
+        }
+
+        return {};
+    }
+
+    // The number of needles is a template parameter to unroll the comparisons of each word
+    template<usize NeedleCount>
+    static Optional<usize> find_any_of_in_words(const char *data, usize size, const char *needles)
+    {
+        auto is_needle = [&](char value) {
+            for (usize index = 0; index < NeedleCount; ++index) {
+                if (value == needles[index])
+                    return true;
+            }
+            return false;
+        };
+
+        usize offset = 0;
+
+        for (; offset < size && !is_aligned(data + offset); ++offset) {
+            if (is_needle(data[offset]))
+                return offset;
+        }
+
+        Word patterns[NeedleCount];
+        for (usize index = 0; index < NeedleCount; ++index)
+            patterns[index] = broadcast(needles[index]);
+
+        for (; offset + sizeof(Word) <= size; offset += sizeof(Word)) {
+            Word word = load(data + offset);
+
+            // The lowest flagged byte of each mask is a real match, thus the lowest byte of the union is as well
+            Word mask = 0;
+            for (usize index = 0; index < NeedleCount; ++index)
+                mask |= zero_bytes(word ^ patterns[index]);
+
+            if (mask != 0)
+                return offset + lowest_byte(mask);
+        }
+
+        for (; offset < size; ++offset) {
+            if (is_needle(data[offset]))
+                return offset;
+        }
+
+        return {};
+    }
+
+    Optional<usize> find_any_of(const char *data, usize size, const char *needles, usize needle_count)
+    {
+        switch (needle_count) {
+        case 0:
+            return {};
+        case 1:
+            return find_byte(data, size, needles[0]);
+        case 2:
+            return find_any_of_in_words<2>(data, size, needles);
+        case 3:
+            return find_any_of_in_words<3>(data, size, needles);
+        case 4:
+            return find_any_of_in_words<4>(data, size, needles);
+        default:
+            return find_any_of_in_table(data, size, needles, needle_count);
+        }
+    }
+
+    Optional<usize> find_bytes(const char *data, usize size, const char *needle, usize needle_size)
+    {
+        if (needle_size == 0)
+            return 0;
+
+        if (needle_size > size)
+            return {};
+
+        // The last offset at which the needle still fits
+        usize last_offset = size - needle_size;
+
+        usize offset = 0;
+        while (offset <= last_offset) {
+            auto index = find_byte(data + offset, last_offset - offset + 1, needle[0]);
+
+            if (!index.is_valid())
+                return {};
+
+            offset += index.value();
+
+            if (compare_bytes(data + offset + 1, needle + 1, needle_size - 1) == 0)
+                return offset;
+
+            ++offset;
+        }
+
+        return {};
+    }
+
+    int compare_bytes(const char *lhs, const char *rhs, usize size)
+    {
+        usize offset = 0;
+
+        // Words can only be compared if both sides become aligned at the same offset
+        if (((uptr(lhs) ^ uptr(rhs)) & (sizeof(Word) - 1)) == 0) {
+            for (; offset < size && !is_aligned(lhs + offset); ++offset) {
+                if (lhs[offset] != rhs[offset])
+                    return int(u8(lhs[offset])) - int(u8(rhs[offset]));
+            }
+
+            for (; offset + sizeof(Word) <= size; offset += sizeof(Word)) {
+                Word difference = load(lhs + offset) ^ load(rhs + offset);
+
+                if (difference != 0) {
+                    offset += lowest_byte(difference);
+                    return int(u8(lhs[offset])) - int(u8(rhs[offset]));
+                }
+            }
+        }
+
+        for (; offset < size; ++offset) {
+            if (lhs[offset] != rhs[offset])
+                return int(u8(lhs[offset])) - int(u8(rhs[offset]));
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Std/Forward.hpp>
+#include <Std/Optional.hpp>
+
+// Searching and comparing bytes a word at a time.  The word is 32 bits on the device and 64 bits on the host,
+// only aligned words are loaded and nothing is read outside of the given ranges.
+namespace Std
+{
+    // Offset of the first 'needle' in 'data'.
+    Optional<usize> find_byte(const char *data, usize size, char needle);
+
+    // Offset of the first byte in 'data' that is one of the 'needle_count' bytes in 'needles'.
+    Optional<usize> find_any_of(const char *data, usize size, const char *needles, usize needle_count);
+
+    // Offset of the first occurrence of 'needle' in 'data', an empty needle is found at offset zero.
+    Optional<usize> find_bytes(const char *data, usize size, const char *needle, usize needle_size);
+
+    // Compares like 'memcmp', the bytes are compared as unsigned values.
+    int compare_bytes(const char *lhs, const char *rhs, usize size);
+}
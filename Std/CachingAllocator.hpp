@@ -0,0 +1,310 @@
+#pragma once
+
+#include <Std/MemoryAllocator.hpp>
+#include <Std/TlsfAllocator.hpp>
+#include <Std/HeapTrace.hpp>
+
+namespace Std
+{
+    // Recently freed small blocks of one thread, kept in one magazine per size class.  Only the owning thread may
+    // use it, thus no lock is needed.  The blocks count as allocated in the statistics of the heap.
+    struct AllocationCache {
+        static constexpr usize size_class_count = 4;
+        static constexpr usize size_classes[size_class_count] = { 8, 16, 32, 64 };
+
+        // The heap is small, a thread must not hoard too much of it
+        static constexpr usize magazine_capacity = 8;
+        static constexpr usize batch_size = magazine_capacity / 2;
+
+        struct Magazine {
+            u8 *m_blocks[magazine_capacity];
+            usize m_count = 0;
+        };
+
+        // Returns 'size_class_count' if the allocation is too large to be cached
+        static usize size_class_for(usize size)
+        {
+            for (usize index = 0; index < size_class_count; ++index) {
+                if (size <= size_classes[index])
+                    return index;
+            }
+            return size_class_count;
+        }
+
+        // A block is put into the largest class it can serve
+        static usize size_class_of_block(usize usable_size)
+        {
+            if (usable_size < size_classes[0] || usable_size >= 2 * size_classes[size_class_count - 1])
+                return size_class_count;
+
+            usize index = size_class_count - 1;
+            while (size_classes[index] > usable_size)
+                --index;
+            return index;
+        }
+
+        usize cached_block_count() const
+        {
+            usize count = 0;
+            for (auto& magazine : m_magazines)
+                count += magazine.m_count;
+            return count;
+        }
+
+        Magazine m_magazines[size_class_count];
+    };
+
+    // Puts per thread caches in front of a shared 'MemoryAllocator' or 'TlsfAllocator'.  Small blocks are taken from
+    // and returned to the cache of the calling thread without locking.  Only if a magazine runs empty or full, a
+    // batch of blocks is moved from or to the shared heap under the lock.
+    //
+    // A 'Guard' object is held for every access to the shared heap, in the kernel it masks interrupts.  Calls
+    // without a cache go straight to the shared heap.
+    //
+    // If the heap is exhausted, it grows by another region from 'm_grow_callback'.  Regions that become entirely
+    // free are handed to 'm_release_callback'.  Both are called without holding the lock.
+    template<typename Backend, typename Guard>
+    class CachingAllocator : public Backend {
+    public:
+        using Statistics = typename Backend::Statistics;
+
+        explicit CachingAllocator(Bytes heap)
+            : Backend(heap)
+        {
+        }
+
+        // Returns memory for a region of at least 'size' bytes, or an empty span
+        Bytes (*m_grow_callback)(usize size) = nullptr;
+
+        // Takes back a region that was returned by 'm_grow_callback'
+        void (*m_release_callback)(Bytes) = nullptr;
+
+        u8* allocate(usize size, bool debug_override = true, void *address = nullptr)
+        {
+            if (address == nullptr)
+                address = __builtin_return_address(0);
+
+            u8 *pointer = try_allocate_or_grow(size);
+            VERIFY(pointer != nullptr);
+
+            if (this->m_debug && debug_override)
+                HeapTrace::allocate(address, pointer, size);
+
+            return pointer;
+        }
+        void deallocate(u8 *pointer, bool debug_override = true, void *address = nullptr)
+        {
+            if (pointer == nullptr)
+                return;
+
+            if (address == nullptr)
+                address = __builtin_return_address(0);
+
+            if (this->m_debug && debug_override)
+                HeapTrace::deallocate(address, pointer);
+
+            Bytes region;
+            {
+                Guard guard;
+                Backend::deallocate(pointer, false);
+                region = take_releasable_region();
+            }
+            release(region);
+        }
+        u8* reallocate(u8 *pointer, usize size, bool debug_override = true, void *address = nullptr)
+        {
+            if (address == nullptr)
+                address = __builtin_return_address(0);
+
+            if (pointer == nullptr)
+                return allocate(size, debug_override, address);
+
+            u8 *new_pointer = pointer;
+            if (!try_reallocate_in_place(pointer, size)) {
+                new_pointer = try_allocate_or_grow(size);
+                VERIFY(new_pointer != nullptr);
+
+                memcpy(new_pointer, pointer, min(size, Backend::usable_size(pointer)));
+                deallocate(pointer, false);
+            }
+
+            if (this->m_debug && debug_override)
+                HeapTrace::reallocate(address, pointer, new_pointer, size);
+
+            return new_pointer;
+        }
+        bool try_reallocate_in_place(u8 *pointer, usize size)
+        {
+            Guard guard;
+            return Backend::try_reallocate_in_place(pointer, size);
+        }
+
+        void add_region(Bytes bytes)
+        {
+            if (this->m_debug)
+                HeapTrace::add_region(bytes);
+
+            Guard guard;
+            Backend::add_region(bytes);
+        }
+
+        Statistics statistics()
+        {
+            Guard guard;
+            return Backend::statistics();
+        }
+
+        u8* allocate(AllocationCache *cache, usize size, bool debug_override = true, void *address = nullptr)
+        {
+            if (address == nullptr)
+                address = __builtin_return_address(0);
+
+            if (cache == nullptr)
+                return allocate(size, debug_override, address);
+
+            usize size_class = AllocationCache::size_class_for(size);
+            if (size_class == AllocationCache::size_class_count)
+                return allocate_or_flush(*cache, size, debug_override, address);
+
+            auto& magazine = cache->m_magazines[size_class];
+            if (magazine.m_count == 0 && !refill(magazine, size_class))
+                return allocate_or_flush(*cache, size, debug_override, address);
+
+            // If the thread is killed in between, the block is leaked but the magazine stays consistent
+            usize count = magazine.m_count - 1;
+            u8 *pointer = magazine.m_blocks[count];
+            magazine.m_count = count;
+
+            if (this->m_debug && debug_override)
+                HeapTrace::allocate(address, pointer, size);
+
+            return pointer;
+        }
+
+        void deallocate(AllocationCache *cache, u8 *pointer, bool debug_override = true, void *address = nullptr)
+        {
+            if (pointer == nullptr)
+                return;
+
+            if (address == nullptr)
+                address = __builtin_return_address(0);
+
+            // The block is owned by the caller, thus its size can be read without the lock.  Only the flags in the
+            // header are updated when a neighbour changes, a single word is never read partially.
+            usize size_class = AllocationCache::size_class_of_block(Backend::usable_size(pointer));
+            if (cache == nullptr || size_class == AllocationCache::size_class_count)
+                return deallocate(pointer, debug_override, address);
+
+            if (this->m_debug && debug_override)
+                HeapTrace::deallocate(address, pointer);
+
+            auto& magazine = cache->m_magazines[size_class];
+            if (magazine.m_count == AllocationCache::magazine_capacity)
+                drain(magazine, AllocationCache::batch_size);
+
+            usize count = magazine.m_count;
+            magazine.m_blocks[count] = pointer;
+            magazine.m_count = count + 1;
+        }
+
+        // Returns every block in the cache to the shared heap, this must be done before the cache is destroyed.
+        void flush(AllocationCache& cache)
+        {
+            for (auto& magazine : cache.m_magazines)
+                drain(magazine, magazine.m_count);
+        }
+
+    private:
+        u8* try_allocate_or_grow(usize size)
+        {
+            for (;;) {
+                {
+                    Guard guard;
+                    if (u8 *pointer = Backend::try_allocate(size))
+                        return pointer;
+                }
+
+                if (m_grow_callback == nullptr)
+                    return nullptr;
+
+                Bytes region = m_grow_callback(Backend::region_size_for(size));
+                if (region.is_empty())
+                    return nullptr;
+
+                add_region(region);
+            }
+        }
+
+        u8* allocate_or_flush(AllocationCache& cache, usize size, bool debug_override, void *address)
+        {
+            u8 *pointer;
+            {
+                Guard guard;
+                pointer = Backend::try_allocate(size);
+            }
+
+            if (pointer == nullptr) {
+                // The blocks in this cache may be merged into something useful before the heap has to grow
+                flush(cache);
+                return allocate(size, debug_override, address);
+            }
+
+            if (this->m_debug && debug_override)
+                HeapTrace::allocate(address, pointer, size);
+
+            return pointer;
+        }
+
+        bool refill(AllocationCache::Magazine& magazine, usize size_class)
+        {
+            Guard guard;
+
+            while (magazine.m_count < AllocationCache::batch_size) {
+                u8 *pointer = Backend::try_allocate(AllocationCache::size_classes[size_class]);
+                if (pointer == nullptr)
+                    break;
+
+                magazine.m_blocks[magazine.m_count++] = pointer;
+            }
+
+            return magazine.m_count > 0;
+        }
+
+        void drain(AllocationCache::Magazine& magazine, usize count)
+        {
+            Bytes region;
+            {
+                Guard guard;
+
+                while (count-- > 0)
+                    Backend::deallocate(magazine.m_blocks[--magazine.m_count], false);
+
+                region = take_releasable_region();
+            }
+            release(region);
+        }
+
+        // Must be called while holding the lock
+        Bytes take_releasable_region()
+        {
+            if (m_release_callback == nullptr)
+                return {};
+
+            return Backend::take_free_region();
+        }
+
+        // Further regions may have become free at the same time
+        void release(Bytes region)
+        {
+            while (!region.is_empty()) {
+                if (this->m_debug)
+                    HeapTrace::remove_region(region);
+
+                m_release_callback(region);
+
+                Guard guard;
+                region = Backend::take_free_region();
+            }
+        }
+    };
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <Std/Vector.hpp>
+#include <Std/Allocator.hpp>
 #include <Std/StringBuilder.hpp>
+#include <Std/Concepts.hpp>
+#include <Std/Relocate.hpp>
 
 namespace Std
 {
@@ -37,7 +40,7 @@ namespace Std
                 auto& target = *reinterpret_cast<T*>(m_data + offset * sizeof(T));
 
                 builder.append(prefix);
-                builder.appendf("%", target);
+                builder.appendf("{}", target);
 
                 prefix = ", ";
             }
@@ -160,4 +163,287 @@ namespace Std
         usize m_size;
         u8 m_data[sizeof(T) * Size];
     };
+
+    // Like 'CircularQueue' but the storage is allocated on the heap and grows as needed.  The capacity is
+    // always a power of two, which allows wrapping indices with a mask.  Memory is only returned by 'shrink_to_fit'.
+    template<typename T, typename Allocator = HeapAllocator>
+    class GrowableCircularQueue {
+    public:
+        static constexpr usize minimum_capacity = 4;
+
+        GrowableCircularQueue(Allocator allocator = {})
+            : m_allocator(allocator)
+        {
+            m_data = nullptr;
+            m_capacity = 0;
+            m_head = 0;
+            m_size = 0;
+        }
+        ~GrowableCircularQueue()
+        {
+            clear();
+            deallocate();
+        }
+        GrowableCircularQueue(GrowableCircularQueue&& other)
+            : GrowableCircularQueue(other.m_allocator)
+        {
+            *this = move(other);
+        }
+
+        void dump()
+        {
+            StringBuilder builder;
+
+            builder.append("[ ");
+
+            const char *prefix = "";
+            for (usize index = 0; index < m_size; ++index) {
+                builder.append(prefix);
+                builder.appendf("{}", (*this)[index]);
+
+                prefix = ", ";
+            }
+
+            builder.append(" ]");
+
+            dbgln("{}", builder);
+        }
+
+        T& enqueue(const T& value)
+        {
+            if (m_size < m_capacity)
+                return enqueue_impl(value);
+
+            // The value could be part of this queue
+            T copy { value };
+            return enqueue_impl(move(copy));
+        }
+        T& enqueue(T&& value)
+        {
+            return enqueue_impl(move(value));
+        }
+
+        T& enqueue_front(const T& value)
+        {
+            if (m_size < m_capacity)
+                return enqueue_front_impl(value);
+
+            // The value could be part of this queue
+            T copy { value };
+            return enqueue_front_impl(move(copy));
+        }
+        T& enqueue_front(T&& value)
+        {
+            return enqueue_front_impl(move(value));
+        }
+
+        T& front()
+        {
+            ASSERT(m_size > 0);
+            return m_data[m_head];
+        }
+        T& back()
+        {
+            ASSERT(m_size > 0);
+            return *slot(m_size - 1);
+        }
+
+        T& operator[](usize index)
+        {
+            ASSERT(m_size > index);
+            return *slot(index);
+        }
+        const T& operator[](usize index) const
+        {
+            ASSERT(m_size > index);
+            return *slot(index);
+        }
+
+        T dequeue()
+        {
+            auto& target = front();
+
+            T value = move(target);
+            target.~T();
+
+            m_head = (m_head + 1) & mask();
+            --m_size;
+
+            return value;
+        }
+        T dequeue_back()
+        {
+            auto& target = back();
+
+            T value = move(target);
+            target.~T();
+
+            --m_size;
+
+            return value;
+        }
+
+        usize size() const { return m_size; }
+        usize capacity() const { return m_capacity; }
+
+        // Provides room for 'new_capacity' elements, afterwards, enqueueing up to that many elements will not allocate.
+        void ensure_capacity(usize new_capacity)
+        {
+            if (m_capacity >= new_capacity)
+                return;
+
+            grow(capacity_for(new_capacity));
+        }
+
+        // Reduces the capacity to the smallest power of two that holds all elements, releases the storage if empty.
+        void shrink_to_fit()
+        {
+            if (m_size == 0) {
+                deallocate();
+
+                m_capacity = 0;
+                m_head = 0;
+                return;
+            }
+
+            usize new_capacity = capacity_for(m_size);
+            if (new_capacity < m_capacity)
+                reallocate(new_capacity);
+        }
+
+        void clear()
+        {
+            for (usize index = 0; index < m_size; ++index)
+                slot(index)->~T();
+
+            m_head = 0;
+            m_size = 0;
+        }
+
+        GrowableCircularQueue& operator=(GrowableCircularQueue&& other)
+        {
+            if (this == &other)
+                return *this;
+
+            clear();
+            deallocate();
+
+            // The storage can only be freed by the allocator it came from
+            m_allocator = other.m_allocator;
+
+            m_data = exchange(other.m_data, nullptr);
+            m_capacity = exchange(other.m_capacity, 0);
+            m_head = exchange(other.m_head, 0);
+            m_size = exchange(other.m_size, 0);
+
+            return *this;
+        }
+
+    private:
+        usize mask() const { return m_capacity - 1; }
+
+        T* slot(usize index) { return m_data + ((m_head + index) & mask()); }
+        const T* slot(usize index) const { return m_data + ((m_head + index) & mask()); }
+
+        static usize capacity_for(usize count)
+        {
+            usize capacity = minimum_capacity;
+            while (capacity < count)
+                capacity *= 2;
+
+            return capacity;
+        }
+
+        template<typename T_>
+        T& enqueue_impl(T_&& value)
+        {
+            if (m_size == m_capacity) [[unlikely]]
+                grow(capacity_for(m_size + 1));
+
+            T *pointer = new (slot(m_size)) T { forward<T_>(value) };
+            ++m_size;
+
+            return *pointer;
+        }
+
+        template<typename T_>
+        T& enqueue_front_impl(T_&& value)
+        {
+            if (m_size == m_capacity) [[unlikely]]
+                grow(capacity_for(m_size + 1));
+
+            m_head = (m_head - 1) & mask();
+
+            T *pointer = new (m_data + m_head) T { forward<T_>(value) };
+            ++m_size;
+
+            return *pointer;
+        }
+
+        // Kept out of line, this way the common case of enqueueing can be inlined.
+        [[gnu::noinline]]
+        void grow(usize new_capacity)
+        {
+            ASSERT(new_capacity > m_capacity);
+
+            if (!Concepts::TriviallyRelocatable<T> || m_data == nullptr) {
+                reallocate(new_capacity);
+                return;
+            }
+
+            // The allocator may be able to extend the allocation, then only the wrapped part has to be moved
+            T *new_data = reinterpret_cast<T*>(m_allocator.reallocate(m_data, sizeof(T) * m_capacity, sizeof(T) * new_capacity));
+            ASSERT(new_data != nullptr);
+
+            usize old_capacity = m_capacity;
+            if (m_head + m_size > old_capacity) {
+                // The capacity at least doubles, thus the wrapped elements fit behind the old end
+                relocate(new_data + old_capacity, new_data, m_head + m_size - old_capacity);
+            }
+
+            m_data = new_data;
+            m_capacity = new_capacity;
+        }
+
+        void reallocate(usize new_capacity)
+        {
+            ASSERT(new_capacity >= m_size);
+
+            T *new_data = reinterpret_cast<T*>(m_allocator.allocate(sizeof(T) * new_capacity));
+            ASSERT(new_data != nullptr);
+
+            if (m_size > 0) {
+                usize first_count = min(m_size, m_capacity - m_head);
+
+                relocate(new_data, m_data + m_head, first_count);
+                relocate(new_data + first_count, m_data, m_size - first_count);
+            }
+
+            deallocate();
+
+            m_data = new_data;
+            m_capacity = new_capacity;
+            m_head = 0;
+        }
+
+        void deallocate()
+        {
+            if (m_data != nullptr)
+                m_allocator.deallocate(m_data, sizeof(T) * m_capacity);
+
+            m_data = nullptr;
+        }
+
+        T *m_data;
+        usize m_capacity;
+        usize m_head;
+        usize m_size;
+
+        [[no_unique_address]]
+        Allocator m_allocator;
+    };
+
+    template<typename T, typename Allocator>
+    struct IsTriviallyRelocatable<GrowableCircularQueue<T, Allocator>> : IntegralConstant<bool, true> {
+    };
 }
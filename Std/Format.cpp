@@ -7,55 +7,130 @@
 # include <iostream>
 #elif defined(KERNEL)
 # include <Kernel/ConsoleDevice.hpp>
-# include <Kernel/KernelMutex.hpp>
+# include <Kernel/KernelLog.hpp>
 #else
 # error "Only TEST and KERNEL are supported"
 #endif
 
 namespace Std
 {
-#ifdef KERNEL
-    static Kernel::KernelMutex dbgln_mutex;
-#endif
-
     void dbgln_raw(StringView str)
     {
 #ifdef TEST
         std::cout << "\e[36m" << std::string_view { str.data(), str.size() } << "\e[0m\n";
 #else
+        if (Kernel::KernelLog::is_initialized()) {
+            Kernel::KernelLog::the().write(str);
+            return;
+        }
+
+        // Early during boot, the output is written synchronously
         StringBuilder builder;
         builder.append("\e[36m");
         builder.append(str);
         builder.append("\e[0m\n");
 
-        dbgln_mutex.lock();
-
         Kernel::ConsoleFileHandle handle;
         handle.write(builder.view().bytes());
+#endif
+    }
+
+#ifdef KERNEL_BINARY_LOG
+    void dbgln_binary_raw(ReadonlyBytes record)
+    {
+        if (Kernel::KernelLog::is_initialized()) {
+            Kernel::KernelLog::the().write({ reinterpret_cast<const char*>(record.data()), record.size() });
+            return;
+        }
 
-        dbgln_mutex.unlock();
+        Kernel::ConsoleFileHandle handle;
+        handle.write(record);
+    }
 #endif
+
+    void format_string_error(const char *message)
+    {
+        // Only reachable from the constructor of 'FormatString' which is evaluated at compile time
+        crash("%condition\n", message, __FILE__, __LINE__);
+    }
+
+    template<usize Base>
+    static constexpr Array<char, Base * Base * 2> digit_pairs = [] {
+        Array<char, Base * Base * 2> table;
+
+        for (usize value = 0; value < Base * Base; ++value) {
+            table[value * 2] = "0123456789abcdef"[value / Base];
+            table[value * 2 + 1] = "0123456789abcdef"[value % Base];
+        }
+
+        return table;
+    }();
+
+    // Negating in the unsigned type avoids overflowing for the smallest value.  Values that fit are kept in
+    // 32 bits, 64-bit division is expensive on the target.
+    template<typename T>
+    static constexpr auto magnitude(T value)
+    {
+        using Unsigned = typename Conditional<sizeof(T) <= sizeof(u32), u32, u64>::Type;
+
+        if (value < 0)
+            return Unsigned(0) - static_cast<Unsigned>(value);
+        return static_cast<Unsigned>(value);
     }
 
     template<typename T>
     requires Concepts::Integral<T>
     void Formatter<T>::format(StringBuilder& builder, T value)
     {
-        if (value < 0) {
-            builder.append('-');
-            return format(builder, -value);
+        auto remaining = magnitude(value);
+
+        char buffer[3 + sizeof(T) * 2];
+        char *end = buffer + sizeof(buffer);
+        char *begin = end;
+
+        for (usize index = 0; index < sizeof(T); ++index) {
+            begin -= 2;
+            memcpy(begin, &digit_pairs<16>[(remaining & 0xff) * 2], 2);
+            remaining >>= 8;
         }
 
-        builder.append("0x");
+        *--begin = 'x';
+        *--begin = '0';
+
+        if (value < 0)
+            *--begin = '-';
+
+        builder.append(StringView { begin, usize(end - begin) });
+    }
+
+    template<typename T>
+    requires Concepts::Integral<T>
+    void Formatter<T>::format_decimal(StringBuilder& builder, T value)
+    {
+        auto remaining = magnitude(value);
 
-        char buffer[sizeof(T) * 2];
-        for (usize index = 0; index < sizeof(buffer); ++index) {
-            buffer[index] = "0123456789abcdef"[value % 16];
-            value /= 16;
+        // Enough for the 20 digits of the largest 64-bit value and the sign
+        char buffer[21];
+        char *end = buffer + sizeof(buffer);
+        char *begin = end;
+
+        while (remaining >= 100) {
+            begin -= 2;
+            memcpy(begin, &digit_pairs<10>[(remaining % 100) * 2], 2);
+            remaining /= 100;
+        }
+
+        if (remaining >= 10) {
+            begin -= 2;
+            memcpy(begin, &digit_pairs<10>[remaining * 2], 2);
+        } else {
+            *--begin = char('0' + remaining);
         }
 
-        for (usize index = 0; index < sizeof(buffer); ++index)
-            builder.append(buffer[(sizeof(buffer) - 1) - index]);
+        if (value < 0)
+            *--begin = '-';
+
+        builder.append(StringView { begin, usize(end - begin) });
     }
 
     void Formatter<StringView>::format(StringBuilder& builder, StringView value)
@@ -78,7 +153,7 @@ namespace Std
 
     void Formatter<Path>::format(StringBuilder& builder, const Path& value)
     {
-        builder.append(value.string());
+        builder.append(value.view());
     }
 
 
@@ -5,12 +5,16 @@
 #include <Std/Array.hpp>
 #include <Std/Vector.hpp>
 #include <Std/Concepts.hpp>
+#include <Std/Hash.hpp>
 #include <Std/String.hpp>
-#include <Std/Lexer.hpp>
 
 namespace Std {
     class StringBuilder;
-    class String;
+
+    template<typename Allocator = HeapAllocator>
+    class BasicString;
+
+    using String = BasicString<>;
 
     template<typename T>
     struct Formatter {
@@ -26,84 +30,142 @@ namespace Std {
         static constexpr bool value = false;
     };
 
-    using FormatFunction = void(*)(StringBuilder&, const void*);
-
-    struct TypeErasedFormatParameter {
-        const void *m_value;
-        FormatFunction m_format;
+    // Selected by the placeholder: '{}' and '{:x}' use the default representation, '{:d}' formats integers in decimal.
+    enum class FormatStyle : u8 {
+        Default,
+        Decimal,
     };
 
-    class TypeErasedFormatParams {
+    // This is not constexpr, reaching it while a format string is parsed at compile time fails the build.
+    void format_string_error(const char *message);
+
+    // The format string is validated against the parameters and split into literal chunks at compile time.
+    // Chunk 'n' precedes the placeholder for parameter 'n', the last chunk follows the last placeholder.
+    template<typename... Parameters>
+    class FormatString {
     public:
-        const TypeErasedFormatParameter& param(usize index) const
-        {
-            ASSERT(index < m_params.size());
-            return m_params[index];
-        }
+        static constexpr usize parameter_count = sizeof...(Parameters);
 
-    protected:
-        void set_params(Span<TypeErasedFormatParameter> params)
+        template<usize Size>
+        consteval FormatString(const char (&fmtstr)[Size])
+            : m_fmtstr(fmtstr)
         {
-            m_params = params;
-        }
+            constexpr bool is_integral[] = { Concepts::Integral<Parameters>..., false };
 
-    private:
-        Span<TypeErasedFormatParameter> m_params;
-    };
+            usize length = Size - 1;
+            usize chunk_index = 0;
+            Chunk chunk { 0, 0, false, FormatStyle::Default };
 
-    template<typename... Parameters>
-    class VariadicFormatParams : public TypeErasedFormatParams {
-    public:
-        explicit VariadicFormatParams(const Parameters&... parameters)
-            : m_params { TypeErasedFormatParameter {
-                &parameters,
-                [](StringBuilder& builder, const void *value)
-                {
-                    Formatter<Parameters>::format(builder, *reinterpret_cast<const Parameters*>(value));
-                },
-            }... }
-        {
-            this->set_params(m_params.span());
+            usize index = 0;
+            while (index < length) {
+                if ((fmtstr[index] == '{' || fmtstr[index] == '}') && index + 1 < length && fmtstr[index + 1] == fmtstr[index]) {
+                    chunk.m_escaped = true;
+                    index += 2;
+                    continue;
+                }
+
+                if (fmtstr[index] == '}')
+                    format_string_error("unmatched '}' in format string");
+
+                if (fmtstr[index] != '{') {
+                    ++index;
+                    continue;
+                }
+
+                chunk.m_size = index - chunk.m_offset;
+
+                usize spec_offset = ++index;
+                while (index < length && fmtstr[index] != '}')
+                    ++index;
+
+                if (index == length)
+                    format_string_error("unmatched '{' in format string");
+
+                usize spec_size = index - spec_offset;
+                if (spec_size == 2 && fmtstr[spec_offset] == ':' && fmtstr[spec_offset + 1] == 'd')
+                    chunk.m_style = FormatStyle::Decimal;
+                else if (spec_size == 2 && fmtstr[spec_offset] == ':' && fmtstr[spec_offset + 1] == 'x')
+                    chunk.m_style = FormatStyle::Default;
+                else if (spec_size != 0)
+                    format_string_error("unknown format specification");
+
+                if (chunk_index == parameter_count)
+                    format_string_error("format string has more placeholders than parameters");
+
+                if (chunk.m_style == FormatStyle::Decimal && !is_integral[chunk_index])
+                    format_string_error("'{:d}' requires an integer parameter");
+
+                m_chunks[chunk_index++] = chunk;
+                chunk = { ++index, 0, false, FormatStyle::Default };
+            }
+
+            if (chunk_index != parameter_count)
+                format_string_error("format string has fewer placeholders than parameters");
+
+            chunk.m_size = length - chunk.m_offset;
+            m_chunks[chunk_index] = chunk;
         }
 
+        void append_chunk(StringBuilder&, usize index) const;
+
+        FormatStyle style(usize index) const { return m_chunks[index].m_style; }
+
     private:
-        Array<TypeErasedFormatParameter, sizeof...(Parameters)> m_params;
+        struct Chunk {
+            usize m_offset;
+            usize m_size;
+
+            // Contains '{{' or '}}', these have to be collapsed while copying
+            bool m_escaped;
+
+            // Style of the placeholder following this chunk
+            FormatStyle m_style;
+        };
+
+        const char *m_fmtstr;
+        Chunk m_chunks[parameter_count + 1] {};
     };
 
-    void vformat(StringBuilder&, StringView fmtstr, TypeErasedFormatParams);
+    template<typename... Parameters>
+    void format_to(StringBuilder&, FormatString<typename TypeIdentity<Parameters>::Type...> fmtstr, const Parameters&...);
 
-    class String {
+    // Strings of up to 'inline_capacity' characters are stored in the object itself, longer strings
+    // are obtained from the allocator.  Whether the inline buffer is used is determined by the size alone.
+    template<typename Allocator>
+    class BasicString {
     public:
-        String()
+        static constexpr usize inline_capacity = 15;
+
+        BasicString(Allocator allocator = {})
+            : m_allocator(allocator)
         {
-            m_buffer_size = 1;
-            m_buffer = new char[m_buffer_size];
-            m_buffer[0] = 0;
+            m_size = 0;
+            m_inline[0] = 0;
         }
-        String(StringView view)
+        BasicString(StringView view, Allocator allocator = {})
+            : m_allocator(allocator)
         {
-            m_buffer_size = view.size() + 1;
-            m_buffer = new char[m_buffer_size];
-            view.strcpy_to({ m_buffer, m_buffer_size });
+            initialize(view);
         }
-        String(const char *str)
-            : String(StringView { str })
+        BasicString(const char *str, Allocator allocator = {})
+            : BasicString(StringView { str }, allocator)
         {
         }
-        String(const String& other)
+        BasicString(const BasicString& other)
+            : m_allocator(other.m_allocator)
         {
-            m_buffer = nullptr;
-            m_buffer_size = 0;
-
-            *this = other;
+            initialize(other.view());
+            m_hash = other.m_hash;
         }
-        String(String&& other)
+        BasicString(BasicString&& other)
+            : m_allocator(other.m_allocator)
         {
-            *this = move(other);
+            take_from(other);
         }
-        ~String()
+        ~BasicString()
         {
-            delete[] m_buffer;
+            if (!is_inline())
+                m_allocator.deallocate(m_heap, m_size + 1);
         }
 
         void strcpy_to(Span<char> other) const
@@ -112,15 +174,21 @@ namespace Std {
         }
 
         template<typename... Parameters>
-        static String format(StringView fmtstr, const Parameters&...);
+        static BasicString format(FormatString<typename TypeIdentity<Parameters>::Type...> fmtstr, const Parameters&...);
 
         // FIXME: Do we want to provide this overload?
-        char* data() { return m_buffer; }
+        char* data()
+        {
+            // The caller may modify the string through this pointer
+            m_hash = 0;
+
+            return buffer();
+        }
 
-        const char* data() const { return m_buffer; }
-        usize size() const { return m_buffer_size - 1; }
+        const char* data() const { return buffer(); }
+        usize size() const { return m_size; }
 
-        const char* cstring() const { return m_buffer; }
+        const char* cstring() const { return buffer(); }
 
         Span<const char> span() const { return { data(), size() }; }
 
@@ -128,33 +196,93 @@ namespace Std {
 
         operator StringView() const { return view(); }
 
-        String& operator=(String&& other)
+        // Computed on first use, must agree with 'Hash<StringView>' to allow heterogeneous lookups.
+        u32 hash() const
         {
-            delete[] m_buffer;
+            if (m_hash == 0)
+                m_hash = Hash<StringView>::compute(view());
 
-            m_buffer = exchange(other.m_buffer, nullptr);
-            m_buffer_size = exchange(other.m_buffer_size, 0);
-            return *this;
+            return m_hash;
         }
-        String& operator=(const String& other)
+
+        BasicString& operator=(BasicString&& other)
         {
-            delete[] m_buffer;
+            if (this != &other) {
+                this->~BasicString();
+
+                // The buffer can only be freed by the allocator it came from
+                m_allocator = other.m_allocator;
+                take_from(other);
+            }
 
-            m_buffer = new char[other.m_buffer_size];
-            m_buffer_size = other.m_buffer_size;
+            return *this;
+        }
+        BasicString& operator=(const BasicString& other)
+        {
+            if (this != &other) {
+                this->~BasicString();
+                initialize(other.view());
+                m_hash = other.m_hash;
+            }
 
-            memcpy(m_buffer, other.m_buffer, m_buffer_size);
             return *this;
         }
 
-        int operator<=>(const String& other) const { return view() <=> other.view(); }
+        int operator<=>(const BasicString& other) const { return view() <=> other.view(); }
 
         // FIXME: The compile should be able to generate this?
-        bool operator==(const String& other) const { return (*this <=> other) == 0; }
+        bool operator==(const BasicString& other) const { return (*this <=> other) == 0; }
+        bool operator==(StringView other) const { return view() == other; }
+        bool operator==(const char *other) const { return view() == StringView { other }; }
 
     private:
-        char *m_buffer = nullptr;
-        usize m_buffer_size;
+        bool is_inline() const { return m_size <= inline_capacity; }
+
+        char* buffer() { return is_inline() ? m_inline : m_heap; }
+        const char* buffer() const { return is_inline() ? m_inline : m_heap; }
+
+        void initialize(StringView view)
+        {
+            m_size = view.size();
+            m_hash = 0;
+
+            if (!is_inline())
+                m_heap = reinterpret_cast<char*>(m_allocator.allocate(m_size + 1));
+
+            view.strcpy_to({ buffer(), m_size + 1 });
+        }
+
+        // Leaves 'other' as an empty string, both must use the same allocator
+        void take_from(BasicString& other)
+        {
+            m_size = other.m_size;
+            m_hash = other.m_hash;
+
+            if (is_inline())
+                memcpy(m_inline, other.m_inline, m_size + 1);
+            else
+                m_heap = other.m_heap;
+
+            other.m_size = 0;
+            other.m_inline[0] = 0;
+            other.m_hash = 0;
+        }
+
+        union {
+            char *m_heap;
+            char m_inline[inline_capacity + 1];
+        };
+        usize m_size;
+
+        // Zero if the hash was not computed yet, a string that actually hashes to zero is simply rehashed
+        mutable u32 m_hash = 0;
+
+        [[no_unique_address]]
+        Allocator m_allocator;
+    };
+
+    template<typename Allocator>
+    struct IsTriviallyRelocatable<BasicString<Allocator>> : IntegralConstant<bool, true> {
     };
 
     class StringBuilder {
@@ -165,13 +293,12 @@ namespace Std {
         }
         void append(StringView value)
         {
-            for (char ch : value.iter())
-                m_data.append(ch);
+            m_data.extend(value);
         }
         template<typename... Parameters>
-        void appendf(StringView fmtstr, const Parameters&... parameters)
+        void appendf(FormatString<typename TypeIdentity<Parameters>::Type...> fmtstr, const Parameters&... parameters)
         {
-            vformat(*this, fmtstr, VariadicFormatParams { parameters... });
+            format_to(*this, fmtstr, parameters...);
         }
 
         char* data() { return m_data.data(); }
@@ -185,78 +312,64 @@ namespace Std {
         Vector<char, 256> m_data;
     };
 
+    template<typename Allocator>
     template<typename... Parameters>
-    String String::format(StringView fmtstr, const Parameters&... parameters)
+    BasicString<Allocator> BasicString<Allocator>::format(FormatString<typename TypeIdentity<Parameters>::Type...> fmtstr, const Parameters&... parameters)
     {
         StringBuilder builder;
-        builder.appendf(fmtstr, parameters...);
-        return builder.string();
+        format_to(builder, fmtstr, parameters...);
+        return BasicString { builder.view() };
     }
 
-    inline void vformat(StringBuilder& builder, StringView fmtstr, TypeErasedFormatParams params)
+    template<typename... Parameters>
+    void FormatString<Parameters...>::append_chunk(StringBuilder& builder, usize index) const
     {
-        usize next_parameter_index = 0;
-        usize curly_brace_level = 0;
-        Lexer lexer { fmtstr };
-
-        while (!lexer.eof()) {
-            if (curly_brace_level == 0) {
-                if (lexer.try_consume("{{")) {
-                    builder.append('{');
-                    continue;
-                }
-
-                if (lexer.try_consume("}}")) {
-                    builder.append('}');
-                    continue;
-                }
-
-                if (lexer.try_consume('{')) {
-                    curly_brace_level = 1;
-                    continue;
-                }
+        const Chunk& chunk = m_chunks[index];
 
-                ASSERT(lexer.peek_or_null() != '}');
+        if (!chunk.m_escaped) {
+            builder.append(StringView { m_fmtstr + chunk.m_offset, chunk.m_size });
+            return;
+        }
 
-                builder.append(lexer.consume());
-            } else {
-                if (lexer.try_consume('{')) {
-                    ++curly_brace_level;
-                    continue;
-                }
+        for (usize offset = 0; offset < chunk.m_size; ++offset) {
+            char ch = m_fmtstr[chunk.m_offset + offset];
+            builder.append(ch);
 
-                if (lexer.try_consume('}')) {
-                    --curly_brace_level;
+            // Skip the second brace of '{{' or '}}'
+            if (ch == '{' || ch == '}')
+                ++offset;
+        }
+    }
 
-                    if (curly_brace_level == 0) {
-                        auto& parameter = params.param(next_parameter_index++);
-                        parameter.m_format(builder, parameter.m_value);
-                    }
+    template<typename T>
+    void format_parameter(StringBuilder& builder, FormatStyle style, const T& value)
+    {
+        if constexpr (Concepts::Integral<T>) {
+            if (style == FormatStyle::Decimal)
+                return Formatter<T>::format_decimal(builder, value);
+        }
 
-                    continue;
-                }
+        Formatter<T>::format(builder, value);
+    }
 
-                lexer.consume();
-            }
-        }
+    template<typename... Parameters>
+    void format_to(StringBuilder& builder, FormatString<typename TypeIdentity<Parameters>::Type...> fmtstr, const Parameters&... parameters)
+    {
+        usize index = 0;
+        ((fmtstr.append_chunk(builder, index), format_parameter(builder, fmtstr.style(index), parameters), ++index), ...);
+        fmtstr.append_chunk(builder, index);
     }
 
     void dbgln_raw(StringView);
 
     template<typename... Parameters>
-    void dbgln(StringView fmtstr, const Parameters&... parameters)
+    void dbgln(FormatString<typename TypeIdentity<Parameters>::Type...> fmtstr, const Parameters&... parameters)
     {
         StringBuilder builder;
-        vformat(builder, fmtstr, VariadicFormatParams { parameters... });
+        format_to(builder, fmtstr, parameters...);
         dbgln_raw(builder.view());
     }
 
-    template<typename... Parameters>
-    void dbgln(const char *fmtstr, const Parameters&... parameters)
-    {
-        return dbgln(StringView { fmtstr }, parameters...);
-    }
-
     inline void dbgln()
     {
         dbgln_raw("");
@@ -265,7 +378,10 @@ namespace Std {
     template<typename T>
     requires Concepts::Integral<T>
     struct Formatter<T> {
+        // Hexadecimal, padded to the width of the type
         static void format(StringBuilder&, T);
+
+        static void format_decimal(StringBuilder&, T);
     };
 
     template<typename T>
@@ -291,8 +407,8 @@ namespace Std {
     struct Formatter<StringView> {
         static void format(StringBuilder&, StringView);
     };
-    template<>
-    struct Formatter<String> : Formatter<StringView> {
+    template<typename Allocator>
+    struct Formatter<BasicString<Allocator>> : Formatter<StringView> {
     };
     template<>
     struct Formatter<const char*> : Formatter<StringView> {
@@ -343,3 +459,7 @@ namespace Std {
 }
 
 using Std::dbgln;
+
+#ifdef KERNEL_BINARY_LOG
+# include <Std/BinaryLog.hpp>
+#endif
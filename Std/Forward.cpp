@@ -9,8 +9,11 @@
 #if defined(TEST)
 # include <iostream>
 # include <cstdlib>
+# include <malloc.h>
 #elif defined(KERNEL)
 # include <Kernel/ConsoleDevice.hpp>
+# include <Kernel/GlobalMemoryAllocator.hpp>
+# include <Kernel/KernelLog.hpp>
 #endif
 
 namespace Std
@@ -40,6 +43,12 @@ namespace Std
 
     void crash(const char *format, const char *condition, const char *file, usize line)
     {
+#if defined(KERNEL)
+        // The messages leading up to the crash are still in the log
+        if (Kernel::KernelLog::is_initialized())
+            Kernel::KernelLog::the().flush();
+#endif
+
         Std::Lexer lexer { format };
 
         while (!lexer.eof()) {
@@ -71,6 +80,18 @@ namespace Std
         asm volatile("bkpt #0");
         for(;;)
             asm volatile("wfi");
+#endif
+    }
+
+    bool try_realloc_in_place(void *pointer, usize size)
+    {
+        if (pointer == nullptr)
+            return false;
+
+#if defined(TEST)
+        return malloc_usable_size(pointer) >= size;
+#elif defined(KERNEL)
+        return Kernel::GlobalMemoryAllocator::the().try_reallocate_in_place(reinterpret_cast<u8*>(pointer), size);
 #endif
     }
 }
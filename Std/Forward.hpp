@@ -29,6 +29,12 @@ struct RemoveReference<T&> {
     using Type = T;
 };
 
+// Wrapping a type in 'TypeIdentity<T>::Type' prevents template argument deduction for that parameter.
+template<typename T>
+struct TypeIdentity {
+    using Type = T;
+};
+
 template<typename T>
 constexpr typename RemoveReference<T>::Type&& move(T&& value)
 {
@@ -73,6 +79,13 @@ inline void strlcpy(char *destination, const char *source, usize size) noexcept
 extern "C"
 void* memcpy(void *destination, const void *source, usize count) noexcept;
 
+extern "C"
+void* malloc(usize size) noexcept;
+extern "C"
+void* realloc(void *pointer, usize size) noexcept;
+extern "C"
+void free(void *pointer) noexcept;
+
 template<typename T>
 constexpr T max(T a, T b)
 {
@@ -110,10 +123,16 @@ namespace Std {
     class Path;
 
     template<typename... Parameters>
-    void dbgln(const char *fmtstr, const Parameters&...);
+    class FormatString;
+
+    template<typename... Parameters>
+    void dbgln(FormatString<typename TypeIdentity<Parameters>::Type...> fmtstr, const Parameters&...);
 
     [[noreturn]]
     void crash(const char *format, const char *condition, const char *file, usize line);
+
+    // Tries to resize a block returned by 'malloc' to 'size' bytes without moving it.
+    bool try_realloc_in_place(void *pointer, usize size);
 }
 
 #define ASSERT(condition) ((condition) ? (void)0 : ::Std::crash("ASSERT(%condition)\n%file:%line\n", #condition, __FILE__, __LINE__))
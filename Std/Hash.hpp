@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Std/Forward.hpp>
+#include <Std/StringView.hpp>
+#include <Std/Concepts.hpp>
+
+namespace Std
+{
+    template<typename T>
+    struct Hash {
+    };
+
+    template<typename T>
+    concept HashDefinedByMember = requires (const T& t) {
+        { t.hash() } -> Concepts::Same<u32>;
+    };
+
+    template<typename T>
+    requires HashDefinedByMember<T>
+    struct Hash<T> {
+        static u32 compute(const T& value)
+        {
+            return value.hash();
+        }
+    };
+
+    template<>
+    struct Hash<u32> {
+        static u32 compute(u32 value)
+        {
+            // https://github.com/skeeto/hash-prospector
+
+            value ^= value >> 16;
+            value *= 0x7feb352d;
+            value ^= value >> 15;
+            value *= 0x846ca68b;
+            value ^= value >> 16;
+
+            return value;
+        }
+    };
+    template<>
+    struct Hash<StringView> {
+        static u32 compute(StringView value)
+        {
+            // https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp (MurmurHash3_x86_32)
+            //
+            // Consumes four bytes at a time.  The words are loaded with memcpy, since the Cortex-M0+ does not
+            // support unaligned loads; on the host this compiles to a single load.
+
+            const u8 *data = reinterpret_cast<const u8*>(value.data());
+            usize size = value.size();
+
+            u32 hash = 0;
+
+            usize index = 0;
+            for (; index + 4 <= size; index += 4) {
+                u32 word;
+                __builtin_memcpy(&word, data + index, sizeof(word));
+
+                hash ^= mix(word);
+                hash = rotate_left(hash, 13);
+                hash = hash * 5 + 0xe6546b64;
+            }
+
+            u32 tail = 0;
+            switch (size - index) {
+            case 3:
+                tail ^= u32(data[index + 2]) << 16;
+                [[fallthrough]];
+            case 2:
+                tail ^= u32(data[index + 1]) << 8;
+                [[fallthrough]];
+            case 1:
+                tail ^= u32(data[index]);
+                hash ^= mix(tail);
+            }
+
+            hash ^= u32(size);
+
+            hash ^= hash >> 16;
+            hash *= 0x85ebca6b;
+            hash ^= hash >> 13;
+            hash *= 0xc2b2ae35;
+            hash ^= hash >> 16;
+
+            return hash;
+        }
+
+    private:
+        static u32 rotate_left(u32 value, u32 count)
+        {
+            return (value << count) | (value >> (32 - count));
+        }
+
+        static u32 mix(u32 word)
+        {
+            word *= 0xcc9e2d51;
+            word = rotate_left(word, 15);
+            word *= 0x1b873593;
+
+            return word;
+        }
+    };
+
+    template<typename T>
+    requires Concepts::Integral<T> && Concepts::HasSizeOf<T, 4>
+    struct Hash<T> {
+        static u32 compute(T value)
+        {
+            return Hash<u32>::compute(bit_cast<u32>(value));
+        }
+    };
+
+    template<typename T>
+    concept Hashable = requires (const T& value) {
+        { Hash<T>::compute(value) } -> Concepts::Same<u32>;
+    };
+}
@@ -5,11 +5,14 @@
 
 namespace Std
 {
-    // FIXME: What about things which can't be compared at all?
-
-    template<typename Key, typename Value>
+    template<typename Key, typename Value, typename Allocator = HeapAllocator>
     class HashMap {
     public:
+        HashMap(Allocator allocator = {})
+            : m_hash(allocator)
+        {
+        }
+
         void clear()
         {
             m_hash.clear();
@@ -34,31 +37,46 @@ namespace Std
 
         Value* get(const Key& key)
         {
-            Node *node = m_hash.search({ key, {} });
-
-            if (node)
-                return &node->m_value.value();
-            else
-                return nullptr;
+            return get_impl(key);
         }
         const Value* get(const Key& key) const
         {
             return const_cast<HashMap*>(this)->get(key);
         }
 
+        // Looks up a key of a different type without converting it, e.g. 'StringView' for 'String' keys.
+        template<typename K>
+        requires HashCompatible<Key, K>
+        Value* get(const K& key)
+        {
+            return get_impl(key);
+        }
+        template<typename K>
+        requires HashCompatible<Key, K>
+        const Value* get(const K& key) const
+        {
+            return const_cast<HashMap*>(this)->get(key);
+        }
+
         Optional<Value> get_opt(const Key& key) const
         {
-            const Node *node = m_hash.search({ key, {} });
+            const Value *value = get(key);
 
-            if (node)
-                return node->m_value;
+            if (value)
+                return *value;
             else
                 return {};
         }
 
         void remove(const Key& key)
         {
-            m_hash.remove({ key, {} });
+            m_hash.remove(KeyReference<Key> { key });
+        }
+        template<typename K>
+        requires HashCompatible<Key, K>
+        void remove(const K& key)
+        {
+            m_hash.remove(KeyReference<K> { key });
         }
 
         usize size() const
@@ -66,27 +84,53 @@ namespace Std
             return m_hash.size();
         }
 
+        void reserve(usize count)
+        {
+            m_hash.reserve(count);
+        }
+
+        // Wraps a key for lookups, the table compares it against the stored keys without creating a 'Node'.
+        template<typename K>
+        struct KeyReference {
+            const K& m_key;
+
+            u32 hash() const { return Hash<K>::compute(m_key); }
+        };
+
         struct Node {
             Key m_key;
             Optional<Value> m_value;
 
             u32 hash() const { return Hash<Key>::compute(m_key); }
 
-            bool operator<(const Node& other) const
+            bool operator==(const Node& other) const
             {
-                return m_key < other.m_key;
+                return hash_table_equals(m_key, other.m_key);
             }
-            bool operator>(const Node& other) const
+
+            template<typename K>
+            bool operator==(const KeyReference<K>& other) const
             {
-                return m_key > other.m_key;
+                return hash_table_equals(m_key, other.m_key);
             }
         };
 
-        using Iterator = HashTable<Node>::Iterator;
+        using Iterator = HashTable<Node, Allocator>::Iterator;
 
         Iterator iter() { return m_hash.iter(); }
 
     private:
-        HashTable<Node> m_hash;
+        template<typename K>
+        Value* get_impl(const K& key)
+        {
+            Node *node = m_hash.search(KeyReference<K> { key });
+
+            if (node)
+                return &node->m_value.value();
+            else
+                return nullptr;
+        }
+
+        HashTable<Node, Allocator> m_hash;
     };
 }
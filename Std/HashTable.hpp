@@ -1,163 +1,177 @@
 #pragma once
 
-#include <Std/SortedSet.hpp>
+#include <Std/Forward.hpp>
+#include <Std/Allocator.hpp>
+#include <Std/Hash.hpp>
+#include <Std/Span.hpp>
+#include <Std/String.hpp>
 #include <Std/Concepts.hpp>
 
 namespace Std
 {
-    template<typename T>
-    struct Hash {
-    };
+    // Types which only define an ordering are considered equal if neither is less than the other.  Integers of
+    // another type are converted to the stored key type first, as if they had been inserted.
+    template<typename T, typename U>
+    bool hash_table_equals(const T& lhs, const U& rhs)
+    {
+        if constexpr (Concepts::Integral<T> && Concepts::Integral<U>)
+            return lhs == static_cast<T>(rhs);
+        else if constexpr (requires { { lhs == rhs } -> Concepts::Same<bool>; })
+            return lhs == rhs;
+        else
+            return !(lhs < rhs) && !(lhs > rhs);
+    }
 
-    template<typename T>
-    concept HashDefinedByMember = requires (const T& t) {
-        { t.hash() } -> Concepts::Same<u32>;
+    // A value of type 'U' can be used to search for entries of type 'T' if both are hashed the same way
+    // and can be compared directly, e.g. 'StringView' for 'String'.
+    template<typename T, typename U>
+    concept HashCompatible = Hashable<U> && requires (const T& lhs, const U& rhs) {
+        { lhs == rhs } -> Concepts::Same<bool>;
     };
 
-    template<typename T>
-    requires HashDefinedByMember<T>
-    struct Hash<T> {
-        static u32 compute(const T& value)
+    // Open addressing with linear probing, the entries of a probe sequence are kept ordered by their
+    // distance from their preferred slot ("Robin Hood hashing").  This allows lookups to terminate
+    // early and entries can be removed by shifting the following entries back, without tombstones.
+    //
+    // The hashes and values are stored in two arrays which share a single allocation; an empty slot
+    // is indicated by a hash of zero.
+    template<typename T, typename Allocator = HeapAllocator>
+    class HashTable {
+    public:
+        HashTable(Allocator allocator = {})
+            : m_allocator(allocator)
         {
-            return value.hash();
+            m_hashes = nullptr;
+            m_values = nullptr;
+            m_capacity = 0;
+            m_size = 0;
         }
-    };
-
-    template<>
-    struct Hash<u32> {
-        static u32 compute(u32 value)
+        ~HashTable()
         {
-            // https://github.com/skeeto/hash-prospector
+            clear();
+        }
 
-            value ^= value >> 16;
-            value *= 0x7feb352d;
-            value ^= value >> 15;
-            value *= 0x846ca68b;
-            value ^= value >> 16;
+        HashTable(const HashTable&) = delete;
 
-            return value;
-        }
-    };
-    template<>
-    struct Hash<StringView> {
-        static u32 compute(StringView value)
+        HashTable(HashTable&& other)
+            : HashTable(other.m_allocator)
         {
-            // http://www.cse.yorku.ca/~oz/hash.html
+            *this = move(other);
+        }
 
-            u32 hash = 5381;
+        void clear()
+        {
+            for (usize index = 0; index < m_capacity; ++index) {
+                if (m_hashes[index] != 0)
+                    m_values[index].~T();
+            }
 
-            for (char ch : value.iter())
-                hash = ((hash << 5) + hash) + ch;
+            if (m_hashes != nullptr)
+                m_allocator.deallocate(m_hashes, storage_size(m_capacity));
 
-            return hash;
+            m_hashes = nullptr;
+            m_values = nullptr;
+            m_capacity = 0;
+            m_size = 0;
         }
-    };
-    template<>
-    struct Hash<String> : Hash<StringView> {
-    };
 
-    template<typename T>
-    requires Concepts::Integral<T> && Concepts::HasSizeOf<T, 4>
-    struct Hash<T> {
-        static u32 compute(T value)
+        // Ensures that 'count' values can be stored without rehashing.
+        void reserve(usize count)
         {
-            return Hash<u32>::compute(bit_cast<u32>(value));
-        }
-    };
+            usize new_capacity = min_capacity;
+            while (new_capacity * max_load_numerator < count * max_load_denominator)
+                new_capacity *= 2;
 
-    template<typename T>
-    class HashTable {
-    public:
-        void clear()
-        {
-            m_set.clear();
+            if (new_capacity > m_capacity)
+                rehash(new_capacity);
         }
 
-        void insert(const T& value)
+        T& insert(const T& value)
         {
-            m_set.insert({ Hash<T>::compute(value), value });
+            return insert_impl(value);
         }
-        void insert(T&& value)
+        T& insert(T&& value)
         {
-            m_set.insert({ Hash<T>::compute(value), move(value) });
+            return insert_impl(move(value));
         }
 
         T* search(const T& value)
         {
-            Node *node = m_set.search({ Hash<T>::compute(value), value });
-
-            if (node)
-                return &node->m_value;
-            else
-                return nullptr;
+            return search_pointer(value, compute_hash(value));
         }
         const T* search(const T& value) const
         {
             return const_cast<HashTable*>(this)->search(value);
         }
 
+        // Searches without constructing a 'T', the caller has to ensure that 'Hash<U>' agrees with 'Hash<T>'.
+        template<typename U>
+        requires HashCompatible<T, U>
+        T* search(const U& key)
+        {
+            return search_pointer(key, compute_hash(key));
+        }
+        template<typename U>
+        requires HashCompatible<T, U>
+        const T* search(const U& key) const
+        {
+            return const_cast<HashTable*>(this)->search(key);
+        }
+
         void remove(const T& value)
         {
-            m_set.remove({ Hash<T>::compute(value), value });
+            remove_impl(value, compute_hash(value));
+        }
+        template<typename U>
+        requires HashCompatible<T, U>
+        void remove(const U& key)
+        {
+            remove_impl(key, compute_hash(key));
         }
 
         usize size() const
         {
-            return m_set.size();
+            return m_size;
+        }
+        usize capacity() const
+        {
+            return m_capacity;
         }
-
-        struct Node {
-            u32 m_hash;
-            T m_value;
-
-            bool operator<(const Node& other) const
-            {
-                if (m_hash < other.m_hash)
-                    return true;
-
-                if (m_hash > other.m_hash)
-                    return false;
-
-                return m_value < other.m_value;
-            }
-            bool operator>(const Node& other) const
-            {
-                if (m_hash > other.m_hash)
-                    return true;
-
-                if (m_hash < other.m_hash)
-                    return false;
-
-                return m_value > other.m_value;
-            }
-        };
 
         class Iterator {
         public:
-            explicit Iterator(SortedSet<Node>::InorderIterator iterator)
-                : m_iterator(iterator)
+            Iterator(HashTable& table, usize index)
+                : m_table(&table)
+                , m_index(index)
             {
+                skip_empty_slots();
             }
 
-            Iterator begin() { return Iterator { m_iterator.begin() }; }
-            Iterator end() { return Iterator { m_iterator.end() }; }
+            Iterator begin() { return *this; }
+            Iterator end() { return Iterator { *m_table, m_table->m_capacity }; }
 
-            const T& operator*() const { return (*m_iterator).m_value; }
-            T& operator*() { return (*m_iterator).m_value; }
+            const T& operator*() const { return m_table->m_values[m_index]; }
+            T& operator*() { return m_table->m_values[m_index]; }
 
             Iterator& operator++()
             {
-                ++m_iterator;
+                ASSERT(m_index < m_table->m_capacity);
+
+                ++m_index;
+                skip_empty_slots();
+
                 return *this;
             }
             Iterator operator++(int)
             {
-                return Iterator { m_iterator++ };
+                Iterator copy = *this;
+                operator++();
+                return copy;
             }
 
             bool operator==(Iterator other) const
             {
-                return m_iterator == other.m_iterator;
+                return m_index == other.m_index;
             }
             bool operator!=(Iterator other) const
             {
@@ -165,12 +179,221 @@ namespace Std
             }
 
         private:
-            SortedSet<Node>::InorderIterator m_iterator;
+            void skip_empty_slots()
+            {
+                while (m_index < m_table->m_capacity && m_table->m_hashes[m_index] == 0)
+                    ++m_index;
+            }
+
+            HashTable *m_table;
+            usize m_index;
         };
 
-        Iterator iter() { return Iterator { m_set.inorder() }; }
+        Iterator iter() { return Iterator { *this, 0 }; }
+
+        HashTable& operator=(HashTable&& other)
+        {
+            clear();
+
+            // The storage can only be freed by the allocator it came from
+            m_allocator = other.m_allocator;
+
+            m_hashes = exchange(other.m_hashes, nullptr);
+            m_values = exchange(other.m_values, nullptr);
+            m_capacity = exchange(other.m_capacity, 0);
+            m_size = exchange(other.m_size, 0);
+
+            return *this;
+        }
 
     private:
-        SortedSet<Node> m_set;
+        static constexpr usize min_capacity = 8;
+
+        // Grow before the table becomes more than three quarters full
+        static constexpr usize max_load_numerator = 3;
+        static constexpr usize max_load_denominator = 4;
+
+        template<typename U>
+        static u32 compute_hash(const U& value)
+        {
+            u32 hash = Hash<U>::compute(value);
+
+            // Zero is reserved for empty slots
+            return hash != 0 ? hash : 1;
+        }
+
+        usize mask() const { return m_capacity - 1; }
+
+        usize distance(usize index) const
+        {
+            return (index - (m_hashes[index] & mask())) & mask();
+        }
+
+        template<typename U>
+        T* search_pointer(const U& key, u32 hash)
+        {
+            Optional<usize> index = search_impl(key, hash);
+
+            if (index.is_valid())
+                return &m_values[index.value()];
+            else
+                return nullptr;
+        }
+
+        template<typename U>
+        void remove_impl(const U& key, u32 hash)
+        {
+            Optional<usize> index_opt = search_impl(key, hash);
+
+            if (!index_opt.is_valid())
+                return;
+
+            usize index = index_opt.value();
+
+            // Shift the following entries back until we find one that is already in its preferred slot
+            for (;;) {
+                usize next_index = (index + 1) & mask();
+
+                if (m_hashes[next_index] == 0 || distance(next_index) == 0)
+                    break;
+
+                m_values[index] = move(m_values[next_index]);
+                m_hashes[index] = m_hashes[next_index];
+
+                index = next_index;
+            }
+
+            m_values[index].~T();
+            m_hashes[index] = 0;
+
+            --m_size;
+        }
+
+        template<typename U>
+        Optional<usize> search_impl(const U& key, u32 hash)
+        {
+            if (m_size == 0)
+                return {};
+
+            usize index = hash & mask();
+            for (usize probe_distance = 0;; ++probe_distance) {
+                if (m_hashes[index] == 0 || distance(index) < probe_distance)
+                    return {};
+
+                if (m_hashes[index] == hash && hash_table_equals(m_values[index], key))
+                    return index;
+
+                index = (index + 1) & mask();
+            }
+        }
+
+        template<typename T_>
+        T& insert_impl(T_&& value)
+        {
+            u32 hash = compute_hash(value);
+
+            Optional<usize> existing_index = search_impl(value, hash);
+            if (existing_index.is_valid()) {
+                T& existing = m_values[existing_index.value()];
+                existing = forward<T_>(value);
+                return existing;
+            }
+
+            if ((m_size + 1) * max_load_denominator > m_capacity * max_load_numerator)
+                rehash(m_capacity == 0 ? min_capacity : m_capacity * 2);
+
+            return insert_new(hash, forward<T_>(value));
+        }
+
+        // The value must not be present in the table yet and there must be at least one empty slot.
+        template<typename T_>
+        T& insert_new(u32 hash, T_&& value)
+        {
+            usize index = insert_position(hash);
+
+            // Make room by shifting the remainder of this probe sequence forward by one slot
+            usize empty_index = index;
+            while (m_hashes[empty_index] != 0)
+                empty_index = (empty_index + 1) & mask();
+
+            if (empty_index != index) {
+                usize previous_index = (empty_index - 1) & mask();
+
+                new (&m_values[empty_index]) T { move(m_values[previous_index]) };
+                m_hashes[empty_index] = m_hashes[previous_index];
+
+                for (usize target_index = previous_index; target_index != index;) {
+                    previous_index = (target_index - 1) & mask();
+
+                    m_values[target_index] = move(m_values[previous_index]);
+                    m_hashes[target_index] = m_hashes[previous_index];
+
+                    target_index = previous_index;
+                }
+
+                m_values[index] = forward<T_>(value);
+            } else {
+                new (&m_values[index]) T { forward<T_>(value) };
+            }
+
+            m_hashes[index] = hash;
+            ++m_size;
+
+            return m_values[index];
+        }
+
+        // Returns the first slot that is empty or whose entry is closer to its preferred slot.
+        usize insert_position(u32 hash) const
+        {
+            usize index = hash & mask();
+            for (usize probe_distance = 0;; ++probe_distance) {
+                if (m_hashes[index] == 0 || distance(index) < probe_distance)
+                    return index;
+
+                index = (index + 1) & mask();
+            }
+        }
+
+        void rehash(usize new_capacity)
+        {
+            ASSERT((new_capacity & (new_capacity - 1)) == 0);
+            ASSERT(new_capacity * max_load_numerator >= m_size * max_load_denominator);
+
+            u32 *old_hashes = m_hashes;
+            T *old_values = m_values;
+            usize old_capacity = m_capacity;
+
+            u8 *storage = reinterpret_cast<u8*>(m_allocator.allocate(storage_size(new_capacity)));
+            ASSERT(storage != nullptr);
+
+            m_hashes = reinterpret_cast<u32*>(storage);
+            m_values = reinterpret_cast<T*>(storage + new_capacity * sizeof(u32));
+            m_capacity = new_capacity;
+
+            for (usize index = 0; index < m_capacity; ++index)
+                m_hashes[index] = 0;
+
+            m_size = 0;
+            for (usize old_index = 0; old_index < old_capacity; ++old_index) {
+                if (old_hashes[old_index] == 0)
+                    continue;
+
+                insert_new(old_hashes[old_index], move(old_values[old_index]));
+                old_values[old_index].~T();
+            }
+
+            if (old_hashes != nullptr)
+                m_allocator.deallocate(old_hashes, storage_size(old_capacity));
+        }
+
+        static usize storage_size(usize capacity) { return capacity * (sizeof(u32) + sizeof(T)); }
+
+        u32 *m_hashes;
+        T *m_values;
+        usize m_capacity;
+        usize m_size;
+
+        [[no_unique_address]]
+        Allocator m_allocator;
     };
 }
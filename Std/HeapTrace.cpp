@@ -0,0 +1,83 @@
+#include <Std/HeapTrace.hpp>
+#include <Std/Format.hpp>
+
+#if defined(KERNEL) && defined(KERNEL_HEAP_TRACE)
+# include <Kernel/Interface/HeapTrace.hpp>
+# include <Kernel/KernelLog.hpp>
+
+# include <hardware/timer.h>
+#endif
+
+namespace Std::HeapTrace
+{
+#if defined(KERNEL) && defined(KERNEL_HEAP_TRACE)
+    static void emit(Kernel::HeapTrace::Kind kind, void *caller, const void *pointer, const void *new_pointer, usize size)
+    {
+        Kernel::HeapTrace::Event event;
+        event.m_magic[0] = Kernel::HeapTrace::magic[0];
+        event.m_magic[1] = Kernel::HeapTrace::magic[1];
+        event.m_kind = kind;
+        event.m_reserved = 0;
+        event.m_timestamp = time_us_32();
+        event.m_caller = u32(uptr(caller));
+        event.m_pointer = u32(uptr(pointer));
+        event.m_new_pointer = u32(uptr(new_pointer));
+        event.m_size = u32(size);
+
+        // The console can not be used before the log is running, the trace must not be started earlier
+        VERIFY(Kernel::KernelLog::is_initialized());
+        Kernel::KernelLog::the().write({ reinterpret_cast<const char*>(&event), sizeof(event) });
+    }
+
+    void start(usize used_bytes)
+    {
+        emit(Kernel::HeapTrace::Kind::Start, nullptr, nullptr, nullptr, used_bytes);
+    }
+    void allocate(void *caller, void *pointer, usize size)
+    {
+        emit(Kernel::HeapTrace::Kind::Allocate, caller, pointer, nullptr, size);
+    }
+    void deallocate(void *caller, void *pointer)
+    {
+        emit(Kernel::HeapTrace::Kind::Deallocate, caller, pointer, nullptr, 0);
+    }
+    void reallocate(void *caller, void *old_pointer, void *new_pointer, usize size)
+    {
+        emit(Kernel::HeapTrace::Kind::Reallocate, caller, old_pointer, new_pointer, size);
+    }
+    void add_region(Bytes bytes)
+    {
+        emit(Kernel::HeapTrace::Kind::AddRegion, nullptr, bytes.data(), nullptr, bytes.size());
+    }
+    void remove_region(Bytes bytes)
+    {
+        emit(Kernel::HeapTrace::Kind::RemoveRegion, nullptr, bytes.data(), nullptr, bytes.size());
+    }
+#else
+    void start(usize used_bytes)
+    {
+        dbgln("\e[32mMTRACE: start {}\e[0m", used_bytes);
+    }
+    void allocate(void *caller, void *pointer, usize size)
+    {
+        dbgln("\e[32mMTRACE: @ {} + {} {}\e[0m", caller, pointer, size);
+    }
+    void deallocate(void *caller, void *pointer)
+    {
+        dbgln("\e[32mMTRACE: @ {} - {}\e[0m", caller, pointer);
+    }
+    void reallocate(void *caller, void *old_pointer, void *new_pointer, usize size)
+    {
+        dbgln("\e[32mMTRACE: @ {} < {}\e[0m", caller, old_pointer);
+        dbgln("\e[32mMTRACE: @ {} > {} {}\e[0m", caller, new_pointer, size);
+    }
+    void add_region(Bytes bytes)
+    {
+        dbgln("\e[32mMTRACE: region + {} {}\e[0m", bytes.data(), bytes.size());
+    }
+    void remove_region(Bytes bytes)
+    {
+        dbgln("\e[32mMTRACE: region - {} {}\e[0m", bytes.data(), bytes.size());
+    }
+#endif
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Std/Span.hpp>
+
+namespace Std::HeapTrace
+{
+    // Reports an operation of a heap that has 'm_debug' set.  In a kernel built with 'KERNEL_HEAP_TRACE', this
+    // emits the events from 'Kernel/Interface/HeapTrace.hpp', otherwise it prints them as 'MTRACE' lines.
+    //
+    // The events are written without allocating, the 'MTRACE' lines are formatted with 'dbgln' which allocates
+    // from the global heap.
+    void start(usize used_bytes);
+
+    void allocate(void *caller, void *pointer, usize size);
+    void deallocate(void *caller, void *pointer);
+    void reallocate(void *caller, void *old_pointer, void *new_pointer, usize size);
+
+    void add_region(Bytes);
+    void remove_region(Bytes);
+}
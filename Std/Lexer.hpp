@@ -48,10 +48,8 @@ namespace Std
             if (str.size() > remaining())
                 return false;
 
-            for (usize i = 0; i < str.size(); ++i) {
-                if (m_input[m_offset + i] != str[i])
-                    return false;
-            }
+            if (compare_bytes(m_input.data() + m_offset, str.data(), str.size()) != 0)
+                return false;
 
             m_offset += str.size();
             return true;
@@ -61,9 +59,11 @@ namespace Std
         {
             usize offset = m_offset;
 
-            while(!eof() && peek_or_null() != ch)
-                consume();
+            if (eof())
+                return m_input.substr(offset, offset);
 
+            auto index = find_byte(m_input.data() + m_offset, remaining(), ch);
+            m_offset = index.is_valid() ? m_offset + index.value() : m_input.size();
 
             return m_input.substr(offset, m_offset);
         }
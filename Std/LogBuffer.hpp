@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Std/Forward.hpp>
+#include <Std/StringView.hpp>
+
+namespace Std
+{
+    // A ring of variable sized messages with multiple producers and a single consumer.  Producers only hold
+    // 'Guard' while they reserve space, the message is copied afterwards and then marked as committed.  The
+    // consumer stops at the first message that is not committed yet, thus messages are read in the order
+    // they were reserved.  Messages that do not fit are dropped and counted.
+    template<usize Size, typename Guard>
+    class LogBuffer {
+    public:
+        static_assert(Size >= 64 && (Size & (Size - 1)) == 0, "Size must be a power of two");
+
+        // Keep the record header encodable and make sure that a message always fits after padding
+        static constexpr usize max_message_size = min<usize>(Size / 2, 0xffff) - 4;
+
+        // Returns false if the message was dropped because there was not enough space.
+        bool try_append(StringView message)
+        {
+            if (message.size() > max_message_size) {
+                Guard guard;
+                ++m_dropped;
+                return false;
+            }
+
+            usize record_size = align(sizeof(Header) + message.size());
+            Header *header;
+
+            {
+                Guard guard;
+
+                u32 reserve_offset = m_reserve_offset;
+                u32 consume_offset = __atomic_load_n(&m_consume_offset, __ATOMIC_ACQUIRE);
+
+                // Records are never split, the rest of the buffer is skipped if the record does not fit
+                usize index = reserve_offset & (Size - 1);
+                usize padding_size = Size - index < record_size ? Size - index : 0;
+
+                u32 used_size = reserve_offset - consume_offset;
+                if (used_size + padding_size + record_size > Size) {
+                    ++m_dropped;
+                    return false;
+                }
+
+                if (padding_size > 0) {
+                    *header_at(index) = { 0, State::Padding, 0 };
+
+                    reserve_offset += padding_size;
+                    index = 0;
+                }
+
+                header = header_at(index);
+                *header = { u16(message.size()), State::Reserved, 0 };
+
+                __atomic_store_n(&m_reserve_offset, reserve_offset + record_size, __ATOMIC_RELEASE);
+            }
+
+            if (message.size() > 0)
+                memcpy(header + 1, message.data(), message.size());
+
+            __atomic_store_n(&header->m_state, State::Committed, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        // Passes all committed messages to 'callback' and releases their space afterwards.  Must not be
+        // called concurrently with itself.  Returns the number of messages.
+        template<typename Callback>
+        usize drain(Callback&& callback)
+        {
+            usize count = 0;
+            u32 consume_offset = m_consume_offset;
+
+            while (consume_offset != __atomic_load_n(&m_reserve_offset, __ATOMIC_ACQUIRE)) {
+                usize index = consume_offset & (Size - 1);
+                Header *header = header_at(index);
+
+                State state = __atomic_load_n(&header->m_state, __ATOMIC_ACQUIRE);
+
+                if (state == State::Reserved)
+                    break;
+
+                if (state == State::Padding) {
+                    consume_offset += Size - index;
+                } else {
+                    callback(StringView { reinterpret_cast<const char*>(header + 1), header->m_size });
+
+                    consume_offset += align(sizeof(Header) + header->m_size);
+                    ++count;
+                }
+
+                __atomic_store_n(&m_consume_offset, consume_offset, __ATOMIC_RELEASE);
+            }
+
+            return count;
+        }
+
+        // Total number of messages that were dropped.
+        usize dropped() const
+        {
+            Guard guard;
+            return m_dropped;
+        }
+
+        bool is_empty() const { return __atomic_load_n(&m_reserve_offset, __ATOMIC_ACQUIRE) == m_consume_offset; }
+
+    private:
+        enum class State : u8 {
+            Reserved,
+            Committed,
+            Padding,
+        };
+
+        struct Header {
+            u16 m_size;
+            State m_state;
+            u8 m_unused;
+        };
+
+        static constexpr usize align(usize size)
+        {
+            return (size + sizeof(Header) - 1) & ~(sizeof(Header) - 1);
+        }
+
+        Header* header_at(usize index)
+        {
+            return reinterpret_cast<Header*>(m_data + index);
+        }
+
+        // These offsets grow without bound and wrap around, only the lower bits are used as index
+        u32 m_reserve_offset = 0;
+        u32 m_consume_offset = 0;
+
+        usize m_dropped = 0;
+
+        alignas(Header) u8 m_data[Size];
+    };
+}
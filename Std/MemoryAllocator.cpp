@@ -3,133 +3,205 @@
 
 namespace Std
 {
-    static usize round_to_word(usize size)
+    MemoryAllocator::MemoryAllocator(Bytes heap)
+        : BoundaryTagAllocator(heap)
     {
-        if (size % 4 != 0)
-            size = size + 4 - size % 4;
-        return size;
+        free_initial_block();
     }
 
-    MemoryAllocator::MemoryAllocator(Bytes heap)
-        : m_heap(heap)
+    void MemoryAllocator::link_free_block(Node *node)
     {
-        m_freelist = reinterpret_cast<Node*>(heap.data());
-        m_freelist->m_size = heap.size() - sizeof(Node);
-        m_freelist->m_next = nullptr;
+        node->m_previous = nullptr;
+        node->m_next = m_freelist;
+
+        if (m_freelist != nullptr)
+            m_freelist->m_previous = node;
+        m_freelist = node;
     }
 
-    u8* MemoryAllocator::allocate(usize size, bool debug_override, void *address)
+    void MemoryAllocator::unlink_free_block(Node *node)
     {
-        if (address == nullptr)
-            address = __builtin_return_address(0);
+        if (node->m_previous != nullptr)
+            node->m_previous->m_next = node->m_next;
+        else
+            m_freelist = node->m_next;
 
-        Node *previous = nullptr;
-        for (Node *entry = m_freelist; entry; entry = entry->m_next)
-        {
-            if (entry->m_size >= size + sizeof(Node))
-            {
-                auto *next = reinterpret_cast<Node*>(entry->m_data + round_to_word(size));
-                next->m_next = entry->m_next;
-                next->m_size = entry->m_size - round_to_word(size) - sizeof(Node);
+        if (node->m_next != nullptr)
+            node->m_next->m_previous = node->m_previous;
+    }
 
-                if (previous)
-                    previous->m_next = next;
-                else
-                    m_freelist = next;
+    usize MemoryAllocator::size_class_for(usize size)
+    {
+        usize size_class = 0;
+        while (size_class < size_class_count && size_classes[size_class] < size)
+            ++size_class;
 
-                entry->m_next = nullptr;
-                entry->m_size = round_to_word(size);
+        return size_class;
+    }
 
-                VERIFY(usize(entry->m_data) % 4 == 0);
+    bool MemoryAllocator::is_slot(u8 *pointer)
+    {
+        usize tag = *reinterpret_cast<usize*>(pointer - sizeof(usize));
+        return tag & 1;
+    }
 
-                if (m_debug && debug_override)
-                    dbgln("\e[32mMTRACE: @ {} + {} {}\e[0m", address, entry->m_data, size);
+    usize MemoryAllocator::usable_size(u8 *pointer)
+    {
+        if (is_slot(pointer)) {
+            auto *slot = reinterpret_cast<Slot*>(pointer - sizeof(usize));
+            auto *slab = reinterpret_cast<Slab*>(reinterpret_cast<u8*>(slot) - (slot->m_tag >> 1));
 
-                return entry->m_data;
-            }
+            return size_classes[slab->m_size_class];
+        }
+
+        return usable_size(node_of(pointer));
+    }
 
-            previous = entry;
+    u8* MemoryAllocator::try_allocate(usize size)
+    {
+        // If no slab can be created, the block is taken from the free list directly
+        usize size_class = size_class_for(size);
+        if (m_use_size_classes && size_class < size_class_count) {
+            if (u8 *pointer = try_allocate_from_slab(size_class))
+                return pointer;
         }
 
-        VERIFY_NOT_REACHED();
+        return try_allocate_from_freelist(size);
     }
 
-    void MemoryAllocator::deallocate(u8 *pointer, bool debug_override, void *address)
+    u8* MemoryAllocator::try_allocate_from_freelist(usize size)
     {
-        if (pointer == nullptr)
-            return;
+        usize needed = block_size_for(size);
+
+        for (Node *entry = m_freelist; entry; entry = entry->m_next) {
+            if (block_size(entry) >= needed)
+                return allocate_block(entry, needed);
+        }
 
-        if (address == nullptr)
-            address = __builtin_return_address(0);
-
-        if (m_debug && debug_override)
-            dbgln("\e[32mMTRACE: @ {} - {}", address, pointer);
-
-        auto *target_entry = reinterpret_cast<Node*>((u8*)pointer - sizeof(Node));
-
-        Node *previous = nullptr;
-        for (auto *entry = m_freelist; entry; entry = entry->m_next)
-        {
-            if (entry > target_entry)
-            {
-                // Try to merge on the left
-                if (previous && previous->m_data + previous->m_size == (u8*)target_entry) {
-                    previous->m_size += sizeof(Node) + target_entry->m_size;
-
-                    // Additionally, try to merge on the right
-                    if (previous->m_data + previous->m_size == (u8*)entry) {
-                        previous->m_size += sizeof(Node) + entry->m_size;
-                        previous->m_next = entry->m_next;
-                    }
-
-                    return;
-                }
-
-                // Try to merge on the right
-                if (target_entry->m_data + target_entry->m_size == (u8*)entry) {
-                    target_entry->m_size += sizeof(Node) + entry->m_size;
-                    target_entry->m_next = entry->m_next;
-                } else {
-                    target_entry->m_next = entry;
-                }
-
-                if (previous)
-                    previous->m_next = target_entry;
-                else
-                    m_freelist = target_entry;
-
-                return;
+        return nullptr;
+    }
+
+    u8* MemoryAllocator::try_allocate_from_slab(usize size_class)
+    {
+        Slab *slab = m_partial_slabs[size_class];
+
+        if (slab == nullptr) {
+            usize slot_count = max(min_slots_per_slab, (target_slab_size - sizeof(Slab)) / slot_size(size_class));
+
+            u8 *memory = try_allocate_from_freelist(sizeof(Slab) + slot_count * slot_size(size_class));
+            if (memory == nullptr)
+                return nullptr;
+
+            slab = reinterpret_cast<Slab*>(memory);
+            slab->m_used_count = 0;
+            slab->m_slot_count = u16(slot_count);
+            slab->m_size_class = u8(size_class);
+            slab->m_free_slots = nullptr;
+
+            // The slots are linked in reverse order, thus the first allocation uses the first slot
+            for (usize index = slot_count; index > 0; --index) {
+                usize offset = sizeof(Slab) + (index - 1) * slot_size(size_class);
+
+                auto *slot = reinterpret_cast<Slot*>(memory + offset);
+                slot->m_tag = (offset << 1) | 1;
+                slot->m_next_free = slab->m_free_slots;
+                slab->m_free_slots = slot;
             }
 
-            previous = entry;
+            link_slab(*slab);
+        }
+
+        Slot *slot = slab->m_free_slots;
+        slab->m_free_slots = slot->m_next_free;
+
+        if (++slab->m_used_count == slab->m_slot_count)
+            unlink_slab(*slab);
+
+        return slot->m_data;
+    }
+
+    void MemoryAllocator::deallocate_block(u8 *pointer)
+    {
+        if (is_slot(pointer))
+            deallocate_to_slab(pointer);
+        else
+            free_block(node_of(pointer));
+    }
+
+    void MemoryAllocator::deallocate_to_slab(u8 *pointer)
+    {
+        auto *slot = reinterpret_cast<Slot*>(pointer - sizeof(usize));
+        auto *slab = reinterpret_cast<Slab*>(reinterpret_cast<u8*>(slot) - (slot->m_tag >> 1));
+
+        if (slab->m_used_count-- == slab->m_slot_count)
+            link_slab(*slab);
+
+        // Empty slabs are returned right away, thus the free list is unchanged if no small blocks are in use
+        if (slab->m_used_count == 0) {
+            unlink_slab(*slab);
+            free_block(node_of(reinterpret_cast<u8*>(slab)));
+            return;
         }
 
-        m_freelist = target_entry;
+        slot->m_next_free = slab->m_free_slots;
+        slab->m_free_slots = slot;
+    }
+
+    void MemoryAllocator::link_slab(Slab& slab)
+    {
+        Slab *&head = m_partial_slabs[slab.m_size_class];
+
+        slab.m_previous = nullptr;
+        slab.m_next = head;
+
+        if (head != nullptr)
+            head->m_previous = &slab;
+        head = &slab;
     }
 
-    u8* MemoryAllocator::reallocate(u8 *pointer, usize size, bool debug_override, void *address)
+    void MemoryAllocator::unlink_slab(Slab& slab)
     {
-        if (address == nullptr)
-            address = __builtin_return_address(0);
+        if (slab.m_previous != nullptr)
+            slab.m_previous->m_next = slab.m_next;
+        else
+            m_partial_slabs[slab.m_size_class] = slab.m_next;
 
-        if (m_debug && debug_override)
-            dbgln("\e[32mMTRACE: @ {} < {}\e[0m", address, pointer);
+        if (slab.m_next != nullptr)
+            slab.m_next->m_previous = slab.m_previous;
+    }
 
-        auto *entry = reinterpret_cast<Node*>((u8*)pointer - sizeof(Node));
+    bool MemoryAllocator::try_reallocate_in_place(u8 *pointer, usize size)
+    {
+        VERIFY(pointer != nullptr);
 
-        if (size < entry->m_size) {
-            if (m_debug && debug_override)
-                dbgln("\e[32mMTRACE: @ {} > {} {}\e[0m", address, pointer, size);
+        // Slots can not grow
+        if (is_slot(pointer))
+            return size <= usable_size(pointer);
 
-            return pointer;
-        }
+        return try_resize_block(node_of(pointer), size);
+    }
+
+    void MemoryAllocator::check_free_blocks(usize free_count)
+    {
+        // Every free block is in the free list and the free list contains nothing else
+        VERIFY(m_freelist == nullptr || m_freelist->m_previous == nullptr);
 
-        u8 *new_pointer = allocate(size, false);
-        memcpy(new_pointer, pointer, entry->m_size);
-        deallocate(pointer, false);
+        usize list_count = 0;
+        for (Node *entry = m_freelist; entry; entry = entry->m_next) {
+            VERIFY(is_free(entry));
+            VERIFY(contains(reinterpret_cast<u8*>(entry)));
 
-        dbgln("\e[32mMTRACE: @ {} > {} {}\e[0m", address, new_pointer, size);
+            ++list_count;
+            VERIFY(list_count <= free_count);
+        }
+        VERIFY(list_count == free_count);
 
-        return new_pointer;
+        for (usize size_class = 0; size_class < size_class_count; ++size_class) {
+            for (Slab *slab = m_partial_slabs[size_class]; slab; slab = slab->m_next) {
+                VERIFY(slab->m_size_class == size_class);
+                VERIFY(slab->m_used_count > 0 && slab->m_used_count < slab->m_slot_count);
+                VERIFY(!is_free(node_of(reinterpret_cast<u8*>(slab))));
+            }
+        }
     }
 }
@@ -1,67 +1,136 @@
 #pragma once
 
 #include <Std/Span.hpp>
+#include <Std/Format.hpp>
+#include <Std/BoundaryTagAllocator.hpp>
 
 namespace Std
 {
-    class MemoryAllocator {
+    // Small allocations are served from per size class slabs, everything else uses a first-fit free list.  The slabs
+    // themselves are blocks of the free list and are returned once they are empty.  The blocks and the regions of
+    // the heap are implemented in 'BoundaryTagAllocator'.
+    class MemoryAllocator : public BoundaryTagAllocator<MemoryAllocator> {
     public:
         explicit MemoryAllocator(Bytes heap);
 
-        usize heap_size() const { return m_heap.size(); }
+        // Returns null instead of crashing if the heap is exhausted, this is not traced.
+        u8* try_allocate(usize);
 
-        u8* allocate(usize, bool debug_override = true, void *address = nullptr);
-        void deallocate(u8*, bool debug_override = true, void *address = nullptr);
-        u8* reallocate(u8*, usize, bool debug_override = true, void *address = nullptr);
+        // Resizes the block without moving it, returns false if it can not grow into the following memory.  If the
+        // block shrinks by a quarter or more, the tail is returned to the free list.
+        bool try_reallocate_in_place(u8*, usize);
+
+        // The number of bytes that can be used in the block, this may be more than was requested.
+        static usize usable_size(u8*);
+        using BoundaryTagAllocator::usable_size;
 
         void dump()
         {
             dbgln("m_freelist:");
             for (auto *entry = m_freelist; entry; entry = entry->m_next)
-                dbgln("  {} ({} bytes)", entry, entry->m_size);
+                dbgln("  {} ({} bytes)", entry, usable_size(entry));
+
+            dbgln("slabs:");
+            for (usize index = 0; index < size_class_count; ++index) {
+                for (auto *slab = m_partial_slabs[index]; slab; slab = slab->m_next)
+                    dbgln("  {} ({} of {} slots of {} bytes used)", slab, slab->m_used_count, slab->m_slot_count, size_classes[index]);
+            }
 
             auto stats = statistics();
 
             dbgln("statistics:");
             dbgln("  m_largest_continous_block {}", stats.m_largest_continous_block);
             dbgln("  m_avaliable_memory        {}", stats.m_avaliable_memory);
+            dbgln("  m_size_class_memory       {}", stats.m_size_class_memory);
         }
 
-        struct Statistics {
-            usize m_largest_continous_block;
-            usize m_avaliable_memory;
-        };
-
         Statistics statistics()
         {
             Statistics stats;
 
             stats.m_largest_continous_block = 0;
             stats.m_avaliable_memory = 0;
+            stats.m_size_class_memory = 0;
 
             for (auto *entry = m_freelist; entry; entry = entry->m_next) {
-                stats.m_avaliable_memory += entry->m_size;
+                stats.m_avaliable_memory += usable_size(entry);
+
+                if (usable_size(entry) > stats.m_largest_continous_block)
+                    stats.m_largest_continous_block = usable_size(entry);
+            }
 
-                if (entry->m_size > stats.m_largest_continous_block)
-                    stats.m_largest_continous_block = entry->m_size;
+            for (usize index = 0; index < size_class_count; ++index) {
+                for (auto *slab = m_partial_slabs[index]; slab; slab = slab->m_next)
+                    stats.m_size_class_memory += (slab->m_slot_count - slab->m_used_count) * size_classes[index];
             }
 
             return stats;
         }
 
-        bool m_debug = false;
+        // Can be changed at any time, blocks from slabs are recognized by their header.
+        bool m_use_size_classes = true;
+
+    private:
+        friend BoundaryTagAllocator;
+
+        static constexpr usize max_block_size = ~usize(0);
+
+        // First fit takes any free block that is large enough
+        static usize free_block_size_for(usize size) { return size; }
+
+        void link_free_block(Node*);
+        void unlink_free_block(Node*);
 
-    protected:
-        struct Node {
-            usize m_size;
-            Node *m_next;
-            u8 m_data[];
+        // Also checks the slabs, they are blocks in use
+        void check_free_blocks(usize free_count);
+
+        static constexpr usize size_class_count = 5;
+        static constexpr usize size_classes[size_class_count] = { 8, 16, 32, 64, 128 };
+
+        // Slabs hold at least 'min_slots_per_slab' slots, more if they fit into 'target_slab_size'
+        static constexpr usize target_slab_size = 512;
+        static constexpr usize min_slots_per_slab = 4;
+
+        // The header word of a block in use is the word before the data, this is where slots keep their tag.  Thus
+        // 'free_flag' is only set in the header of free blocks.
+        //
+        // Every slot starts with a tag word which has the lowest bit set, in the header of a block in use it is
+        // clear.  The remaining bits encode the offset of the slot in its slab.
+        struct Slot {
+            usize m_tag;
+            union {
+                Slot *m_next_free;
+                u8 m_data[1];
+            };
         };
-        static_assert(sizeof(Node) % 4 == 0);
 
-        Bytes m_heap;
+        struct Slab {
+            // Only slabs with free slots are linked into 'm_partial_slabs'
+            Slab *m_next;
+            Slab *m_previous;
 
-    private:
-        Node *m_freelist;
+            Slot *m_free_slots;
+            u16 m_used_count;
+            u16 m_slot_count;
+            u8 m_size_class;
+        };
+
+        static usize size_class_for(usize size);
+        static bool is_slot(u8*);
+        static usize slot_size(usize size_class) { return sizeof(usize) + size_classes[size_class]; }
+
+        u8* try_allocate_from_freelist(usize);
+
+        void deallocate_block(u8*);
+
+        u8* try_allocate_from_slab(usize size_class);
+        void deallocate_to_slab(u8*);
+
+        void link_slab(Slab&);
+        void unlink_slab(Slab&);
+
+        Node *m_freelist = nullptr;
+
+        Slab *m_partial_slabs[size_class_count] = {};
     };
 }
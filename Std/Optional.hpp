@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Std/Forward.hpp>
+#include <Std/Concepts.hpp>
 
 #ifdef TEST
 # include <new>
@@ -128,4 +129,8 @@ namespace Std {
         u8 m_value[sizeof(T)];
         bool m_is_valid = false;
     };
+
+    template<typename T>
+    struct IsTriviallyRelocatable<Optional<T>> : IntegralConstant<bool, IsTriviallyRelocatable<T>::value> {
+    };
 }
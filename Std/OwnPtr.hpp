@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Std/Forward.hpp>
+#include <Std/Concepts.hpp>
 
 namespace Std
 {
@@ -140,4 +141,11 @@ namespace Std
     {
         return new T { forward<Parameters>(parameters)... };
     }
+
+    template<typename T>
+    struct IsTriviallyRelocatable<NonnullOwnPtr<T>> : IntegralConstant<bool, true> {
+    };
+    template<typename T>
+    struct IsTriviallyRelocatable<OwnPtr<T>> : IntegralConstant<bool, true> {
+    };
 }
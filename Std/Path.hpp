@@ -2,12 +2,55 @@
 
 #include <Std/StringBuilder.hpp>
 #include <Std/StringView.hpp>
-#include <Std/Lexer.hpp>
 
 namespace Std
 {
+    // The path is stored normalized in a single buffer: components are separated by a single slash, absolute
+    // paths start with one, '.' components are dropped and '..' removes the preceding component.  Only
+    // relative paths can start with '..' components.  The components are views into this buffer.
     class Path {
     public:
+        class ComponentIterator {
+        public:
+            ComponentIterator(const Path& path, usize index)
+                : m_path(&path)
+                , m_index(index)
+            {
+            }
+
+            StringView operator*() const { return m_path->component(m_index); }
+
+            ComponentIterator& operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            bool operator==(const ComponentIterator& other) const { return m_index == other.m_index; }
+            bool operator!=(const ComponentIterator& other) const { return m_index != other.m_index; }
+
+        private:
+            const Path *m_path;
+            usize m_index;
+        };
+
+        class Components {
+        public:
+            explicit Components(const Path& path)
+                : m_path(path)
+            {
+            }
+
+            usize size() const { return m_path.m_offsets.size(); }
+            StringView operator[](usize index) const { return m_path.component(index); }
+
+            ComponentIterator begin() const { return { m_path, 0 }; }
+            ComponentIterator end() const { return { m_path, size() }; }
+
+        private:
+            const Path& m_path;
+        };
+
         Path()
         {
             m_is_absolute = false;
@@ -16,93 +59,113 @@ namespace Std
         {
             VERIFY(path.size() >= 1);
 
-            Lexer lexer { path };
+            // The normalized path is never longer than the input
+            m_buffer.reserve(path.size());
 
-            m_is_absolute = lexer.try_consume('/');
+            m_is_absolute = path[0] == '/';
+            if (m_is_absolute)
+                m_buffer.append('/');
 
-            while (!lexer.eof())
-            {
-                m_components.append(lexer.consume_until('/'));
+            usize begin = 0;
+            while (begin <= path.size()) {
+                auto index = path.substr(begin).index_of('/');
+                usize end = index.is_valid() ? begin + index.value() : path.size();
 
-                if (!lexer.eof())
-                    lexer.try_consume('/');
+                append_component(path.substr(begin, end));
+                begin = end + 1;
             }
         }
         Path(const char *path)
             : Path(StringView { path })
         {
         }
-        Path(const Path& path)
-            : m_is_absolute(path.m_is_absolute)
-            , m_components(path.m_components)
-        {
-        }
 
         bool is_absolute() const { return m_is_absolute; }
-        auto components() const { return m_components.iter(); }
+        Components components() const { return Components { *this }; }
 
         Path parent() const
         {
-            VERIFY(m_components.size() >= 1);
+            VERIFY(m_offsets.size() >= 1);
 
             Path parent;
             parent.m_is_absolute = m_is_absolute;
+            parent.m_buffer.extend({ m_buffer.data(), prefix_size(m_offsets.size() - 1) });
+            parent.m_offsets.extend({ m_offsets.data(), m_offsets.size() - 1 });
 
-            for (usize i = 0; i < m_components.size() - 1; ++i)
-                parent.m_components.append(m_components[i]);
-
-            return move(parent);
+            return parent;
         }
 
-        String filename() const
+        StringView filename() const
         {
-            VERIFY(m_components.size() >= 1);
-            return m_components[m_components.size() - 1];
+            VERIFY(m_offsets.size() >= 1);
+            return component(m_offsets.size() - 1);
         }
 
-        String string() const
+        StringView view() const { return { m_buffer.data(), m_buffer.size() }; }
+        String string() const { return view(); }
+
+        Path operator/(const Path& rhs) const
         {
-            StringBuilder builder;
+            ASSERT(!rhs.is_absolute());
 
-            if (m_is_absolute && components().size() == 0) {
-                builder.append('/');
-                return builder.string();
-            }
+            Path path = *this;
+            for (StringView component : rhs.components())
+                path.append_component(component);
 
-            bool put_slash = m_is_absolute;
-            for (auto& component : components())
-            {
-                if (put_slash)
-                    builder.append('/');
-                else
-                    put_slash = true;
+            return path;
+        }
 
+    private:
+        // The offsets are kept small, paths are short and a few of them live on every kernel stack
+        static constexpr usize max_size = 0xffff;
 
-                builder.append(component);
-            }
+        StringView component(usize index) const
+        {
+            usize begin = m_offsets[index];
+            usize end = index + 1 < m_offsets.size() ? m_offsets[index + 1] - 1 : m_buffer.size();
 
-            return builder.string();
+            return { m_buffer.data() + begin, end - begin };
         }
 
-        Path operator/(const Path& rhs) const
+        // Size of the buffer if only the first 'count' components were kept
+        usize prefix_size(usize count) const
         {
-            ASSERT(!rhs.is_absolute());
+            if (count == 0)
+                return m_is_absolute ? 1 : 0;
 
-            Path path = *this;
-            path.m_components.extend(rhs.m_components.span());
-            return path;
+            return m_offsets[count] - 1;
         }
 
-        Path& operator=(const Path& rhs)
+        void append_component(StringView name)
         {
-            m_is_absolute = rhs.m_is_absolute;
-            m_components = rhs.m_components;
+            if (name.size() == 0 || name == ".")
+                return;
+
+            if (name == "..") {
+                if (m_offsets.size() >= 1 && filename() != "..") {
+                    usize size = prefix_size(m_offsets.size() - 1);
+
+                    m_offsets.erase(m_offsets.size() - 1);
+                    m_buffer.erase(size, m_buffer.size() - size);
+                    return;
+                }
 
-            return *this;
+                // The parent of the root directory is the root directory itself
+                if (m_is_absolute)
+                    return;
+            }
+
+            if (m_offsets.size() >= 1)
+                m_buffer.append('/');
+
+            VERIFY(m_buffer.size() + name.size() <= max_size);
+
+            m_offsets.append(u16(m_buffer.size()));
+            m_buffer.extend(name);
         }
 
-    private:
         bool m_is_absolute;
-        Vector<String> m_components;
+        Vector<char, 32> m_buffer;
+        Vector<u16, 8> m_offsets;
     };
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Std/Forward.hpp>
+#include <Std/Concepts.hpp>
 #include <Std/Format.hpp>
 
 namespace Std
@@ -142,4 +143,8 @@ namespace Std
     template<typename T>
     struct Formatter<RefPtr<T>> : Formatter<T*> {
     };
+
+    template<typename T>
+    struct IsTriviallyRelocatable<RefPtr<T>> : IntegralConstant<bool, true> {
+    };
 }
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Std/Forward.hpp>
+#include <Std/Concepts.hpp>
+
+namespace Std
+{
+    // Moves 'count' elements into uninitialized memory and ends the lifetime of the originals.  Trivially
+    // relocatable types are copied as bytes, they need not be trivially copyable.
+    template<typename T>
+    void relocate(T *destination, T *source, usize count)
+    {
+        if constexpr (Concepts::TriviallyRelocatable<T>) {
+            if (count > 0)
+                memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+        } else {
+            for (usize index = 0; index < count; ++index) {
+                new (destination + index) T { move(source[index]) };
+                source[index].~T();
+            }
+        }
+    }
+
+    // Like 'relocate', but the ranges may overlap.  Only for trivially relocatable types.
+    template<typename T>
+    requires Concepts::TriviallyRelocatable<T>
+    void relocate_overlapping(T *destination, T *source, usize count)
+    {
+        if (count > 0)
+            __builtin_memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+    }
+}
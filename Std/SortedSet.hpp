@@ -1,16 +1,19 @@
 #pragma once
 
 #include <Std/Forward.hpp>
+#include <Std/Allocator.hpp>
+#include <Std/Span.hpp>
 #include <Std/StringBuilder.hpp>
 
 namespace Std
 {
-    // FIXME: Upgrade to red/black trees
+    // This is a red/black tree, thus the depth is bounded by '2 * log2(size + 1)'.
 
-    template<typename T>
+    template<typename T, typename Allocator = HeapAllocator>
     class SortedSet {
     public:
-        SortedSet()
+        SortedSet(Allocator allocator = {})
+            : m_allocator(allocator)
         {
             m_root = nullptr;
             m_size = 0;
@@ -24,6 +27,7 @@ namespace Std
         SortedSet(const SortedSet&) = delete;
 
         SortedSet(SortedSet&& other)
+            : m_allocator(other.m_allocator)
         {
             m_root = nullptr;
             m_size = 0;
@@ -31,6 +35,11 @@ namespace Std
             *this = move(other);
         }
 
+        enum class Color : u8 {
+            Red,
+            Black,
+        };
+
         struct Node {
             Node(const T& value)
                 : m_value(value)
@@ -38,6 +47,7 @@ namespace Std
                 m_left = nullptr;
                 m_right = nullptr;
                 m_parent = nullptr;
+                m_color = Color::Red;
             }
             Node(T&& value)
                 : m_value(move(value))
@@ -45,11 +55,7 @@ namespace Std
                 m_left = nullptr;
                 m_right = nullptr;
                 m_parent = nullptr;
-            }
-            ~Node()
-            {
-                delete m_left;
-                delete m_right;
+                m_color = Color::Red;
             }
 
             void dump(StringBuilder& builder) const
@@ -101,18 +107,20 @@ namespace Std
             Node *m_left;
             Node *m_right;
             Node *m_parent;
+            Color m_color;
         };
 
         class InorderIterator {
         public:
-            InorderIterator(SortedSet& set, Node *root)
-                : m_set(set)
-                , m_current(root)
+            InorderIterator(SortedSet& set, Node *begin, Node *end = nullptr)
+                : m_set(&set)
+                , m_current(begin)
+                , m_end(end)
             {
             }
 
             InorderIterator begin() { return *this; }
-            InorderIterator end() { return { m_set, nullptr }; }
+            InorderIterator end() { return { *m_set, m_end, m_end }; }
 
             bool is_end() { return *this == end(); }
 
@@ -124,9 +132,7 @@ namespace Std
                 ASSERT(m_current);
 
                 if (m_current->m_right != nullptr) {
-                    Node *parent = nullptr;
-                    m_current = m_set.min_impl(m_current->m_right, &parent);
-
+                    m_current = m_set->min_impl(m_current->m_right);
                     return *this;
                 }
 
@@ -148,24 +154,25 @@ namespace Std
                 return copy;
             }
 
-            bool operator==(InorderIterator& other) const
+            bool operator==(const InorderIterator& other) const
             {
                 return m_current == other.m_current;
             }
-            bool operator!=(InorderIterator& other) const
+            bool operator!=(const InorderIterator& other) const
             {
                 return !operator==(other);
             }
 
         private:
-            SortedSet& m_set;
+            SortedSet *m_set;
             Node *m_current;
+            Node *m_end;
         };
 
         T* search(const T& value)
         {
             Node *parent = nullptr;
-            Node *node = search_impl(value, &parent, m_root);
+            Node *node = search_impl(value, &parent);
 
             if (node != nullptr)
                 return &node->m_value;
@@ -190,14 +197,31 @@ namespace Std
             return insert_impl(move(value));
         }
 
+        // Replaces the content of this set in O(n), the values must be strictly increasing.
+        void build_from_sorted(Span<const T> values)
+        {
+            clear();
+
+            for (usize index = 1; index < values.size(); ++index)
+                VERIFY(values[index - 1] < values[index]);
+
+            // All paths have at least this many black nodes, the remaining nodes on the
+            // incomplete bottom level are colored red.
+            usize red_depth = 0;
+            while ((usize(2) << red_depth) <= values.size() + 1)
+                ++red_depth;
+
+            m_root = build_from_sorted_impl(values, nullptr, 0, red_depth);
+            m_size = values.size();
+        }
+
         const T* min() const
         {
             return const_cast<SortedSet*>(this)->min();
         }
         T* min()
         {
-            Node *parent = nullptr;
-            Node *node = min_impl(m_root, &parent);
+            Node *node = min_impl(m_root);
 
             if (node)
                 return &node->m_value;
@@ -208,36 +232,58 @@ namespace Std
         void remove(const T& value)
         {
             Node *parent = nullptr;
-            Node *node = search_impl(value, &parent, m_root);
+            Node *node = search_impl(value, &parent);
 
             if (node == nullptr)
                 return;
 
-            if (node->m_left == nullptr || node->m_right == nullptr)
-                return remove_impl(node, parent);
-
-            Node *min_in_right_parent = node;
-            Node *min_in_right = min_impl(node->m_right, &min_in_right_parent);
-            ASSERT(min_in_right);
+            if (node->m_left != nullptr && node->m_right != nullptr) {
+                Node *min_in_right = min_impl(node->m_right);
+                ASSERT(min_in_right);
 
-            node->m_value = move(min_in_right->m_value);
+                node->m_value = move(min_in_right->m_value);
+                node = min_in_right;
+            }
 
-            remove_impl(min_in_right, min_in_right_parent);
+            remove_impl(node);
         }
 
         InorderIterator inorder()
         {
-            Node *parent = nullptr;
-            Node *min = min_impl(m_root, &parent);
+            return InorderIterator { *this, min_impl(m_root) };
+        }
+
+        // Iterates starting at the first value that is not less than 'value'.
+        InorderIterator lower_bound(const T& value)
+        {
+            return InorderIterator { *this, lower_bound_impl(value) };
+        }
 
-            return InorderIterator { *this, min };
+        // Iterates over all values in '[lower, upper)'.
+        InorderIterator range(const T& lower, const T& upper)
+        {
+            ASSERT(!(upper < lower));
+            return InorderIterator { *this, lower_bound_impl(lower), lower_bound_impl(upper) };
         }
 
         usize size() const { return m_size; }
 
+        usize depth() const
+        {
+            return depth_impl(m_root);
+        }
+
+        // Crashes if the red/black properties are violated.
+        void verify_invariants() const
+        {
+            VERIFY(color(m_root) == Color::Black);
+            VERIFY(count_nodes_impl(m_root) == m_size);
+            verify_invariants_impl(m_root);
+        }
+
         void clear()
         {
-            delete m_root;
+            destroy_subtree(m_root);
 
             m_root = nullptr;
             m_size = 0;
@@ -247,6 +293,8 @@ namespace Std
         {
             clear();
 
+            // The nodes can only be freed by the allocator they came from
+            m_allocator = other.m_allocator;
             m_root = exchange(other.m_root, nullptr);
             m_size = exchange(other.m_size, 0);
 
@@ -258,101 +306,381 @@ namespace Std
         T& insert_impl(T_&& value)
         {
             Node *parent = nullptr;
-            Node *node = search_impl(value, &parent, m_root);
+            Node *node = search_impl(value, &parent);
 
             if (node) {
                 node->m_value = forward<T_>(value);
 
                 return node->m_value;
-            } else if (parent == nullptr) {
-                node = m_root = new Node { forward<T_>(value) };
-                ++m_size;
+            }
 
-                return node->m_value;
-            } else if (value < parent->m_value) {
+            node = create_node(forward<T_>(value));
+            ++m_size;
+
+            if (parent == nullptr) {
+                m_root = node;
+            } else if (node->m_value < parent->m_value) {
                 ASSERT(parent->m_left == nullptr);
-                node = parent->m_left = new Node { forward<T_>(value) };
+                parent->m_left = node;
                 node->m_parent = parent;
-                ++m_size;
-
-                return node->m_value;
             } else {
-                ASSERT(value > parent->m_value);
+                ASSERT(node->m_value > parent->m_value);
 
                 ASSERT(parent->m_right == nullptr);
-                node = parent->m_right = new Node { forward<T_>(value) };
+                parent->m_right = node;
                 node->m_parent = parent;
-                ++m_size;
+            }
 
-                return node->m_value;
+            insert_fixup(node);
+
+            return node->m_value;
+        }
+
+        Node* search_impl(const T& value, Node **parent)
+        {
+            Node *subtree = m_root;
+
+            while (subtree != nullptr) {
+                if (value < subtree->m_value) {
+                    *parent = subtree;
+                    subtree = subtree->m_left;
+                } else if (value > subtree->m_value) {
+                    *parent = subtree;
+                    subtree = subtree->m_right;
+                } else {
+                    return subtree;
+                }
             }
+
+            return nullptr;
         }
 
-        Node* search_impl(const T& value, Node **parent, Node *subtree)
+        Node* lower_bound_impl(const T& value)
+        {
+            Node *result = nullptr;
+
+            Node *subtree = m_root;
+            while (subtree != nullptr) {
+                if (subtree->m_value < value) {
+                    subtree = subtree->m_right;
+                } else {
+                    result = subtree;
+                    subtree = subtree->m_left;
+                }
+            }
+
+            return result;
+        }
+
+        Node* min_impl(Node* subtree)
         {
             if (subtree == nullptr)
                 return nullptr;
 
-            if (value < subtree->m_value) {
-                *parent = subtree;
-                return search_impl(value, parent, subtree->m_left);
-            } else if (value > subtree->m_value) {
-                *parent = subtree;
-                return search_impl(value, parent, subtree->m_right);
+            while (subtree->m_left != nullptr)
+                subtree = subtree->m_left;
+
+            return subtree;
+        }
+
+        Node* build_from_sorted_impl(Span<const T> values, Node *parent, usize depth, usize red_depth)
+        {
+            if (values.size() == 0)
+                return nullptr;
+
+            usize middle = values.size() / 2;
+
+            Node *node = create_node(values[middle]);
+            node->m_parent = parent;
+            node->m_color = depth == red_depth ? Color::Red : Color::Black;
+
+            node->m_left = build_from_sorted_impl({ values.data(), middle }, node, depth + 1, red_depth);
+            node->m_right = build_from_sorted_impl(values.slice(middle + 1), node, depth + 1, red_depth);
+
+            return node;
+        }
+
+        static Color color(const Node *node)
+        {
+            if (node == nullptr)
+                return Color::Black;
+
+            return node->m_color;
+        }
+
+        void replace_node(Node *old, Node *new_)
+        {
+            if (old->m_parent) {
+                old->m_parent->replace_child(old, new_);
             } else {
-                return subtree;
+                m_root = new_;
+
+                if (new_)
+                    new_->m_parent = nullptr;
             }
         }
 
-        Node* min_impl(Node* subtree, Node **parent)
+        void rotate_left(Node *node)
         {
-            if (subtree == nullptr)
-                return nullptr;
+            Node *pivot = node->m_right;
+            ASSERT(pivot != nullptr);
+
+            node->m_right = pivot->m_left;
+            if (node->m_right)
+                node->m_right->m_parent = node;
+
+            pivot->m_parent = node->m_parent;
+            if (node->m_parent == nullptr)
+                m_root = pivot;
+            else if (node->m_parent->m_left == node)
+                node->m_parent->m_left = pivot;
+            else
+                node->m_parent->m_right = pivot;
+
+            pivot->m_left = node;
+            node->m_parent = pivot;
+        }
+
+        void rotate_right(Node *node)
+        {
+            Node *pivot = node->m_left;
+            ASSERT(pivot != nullptr);
+
+            node->m_left = pivot->m_right;
+            if (node->m_left)
+                node->m_left->m_parent = node;
+
+            pivot->m_parent = node->m_parent;
+            if (node->m_parent == nullptr)
+                m_root = pivot;
+            else if (node->m_parent->m_left == node)
+                node->m_parent->m_left = pivot;
+            else
+                node->m_parent->m_right = pivot;
+
+            pivot->m_right = node;
+            node->m_parent = pivot;
+        }
+
+        void insert_fixup(Node *node)
+        {
+            // Since the root is black, a red parent always has a parent itself
+
+            while (color(node->m_parent) == Color::Red) {
+                Node *parent = node->m_parent;
+                Node *grandparent = parent->m_parent;
+
+                if (parent == grandparent->m_left) {
+                    Node *uncle = grandparent->m_right;
+
+                    if (color(uncle) == Color::Red) {
+                        parent->m_color = Color::Black;
+                        uncle->m_color = Color::Black;
+                        grandparent->m_color = Color::Red;
+                        node = grandparent;
+                        continue;
+                    }
+
+                    if (node == parent->m_right) {
+                        rotate_left(parent);
+                        node = parent;
+                        parent = node->m_parent;
+                    }
+
+                    parent->m_color = Color::Black;
+                    grandparent->m_color = Color::Red;
+                    rotate_right(grandparent);
+                } else {
+                    Node *uncle = grandparent->m_left;
+
+                    if (color(uncle) == Color::Red) {
+                        parent->m_color = Color::Black;
+                        uncle->m_color = Color::Black;
+                        grandparent->m_color = Color::Red;
+                        node = grandparent;
+                        continue;
+                    }
+
+                    if (node == parent->m_left) {
+                        rotate_right(parent);
+                        node = parent;
+                        parent = node->m_parent;
+                    }
+
+                    parent->m_color = Color::Black;
+                    grandparent->m_color = Color::Red;
+                    rotate_left(grandparent);
+                }
+            }
+
+            m_root->m_color = Color::Black;
+        }
 
-            if (subtree->m_left == nullptr)
-                return subtree;
+        // The node is still part of the tree and is treated as if it carried an additional black.
+        void remove_fixup(Node *node)
+        {
+            while (node != m_root && color(node) == Color::Black) {
+                Node *parent = node->m_parent;
+
+                if (node == parent->m_left) {
+                    Node *sibling = parent->m_right;
+
+                    if (color(sibling) == Color::Red) {
+                        sibling->m_color = Color::Black;
+                        parent->m_color = Color::Red;
+                        rotate_left(parent);
+                        sibling = parent->m_right;
+                    }
+
+                    if (color(sibling->m_left) == Color::Black && color(sibling->m_right) == Color::Black) {
+                        sibling->m_color = Color::Red;
+                        node = parent;
+                        continue;
+                    }
+
+                    if (color(sibling->m_right) == Color::Black) {
+                        sibling->m_left->m_color = Color::Black;
+                        sibling->m_color = Color::Red;
+                        rotate_right(sibling);
+                        sibling = parent->m_right;
+                    }
+
+                    sibling->m_color = parent->m_color;
+                    parent->m_color = Color::Black;
+                    sibling->m_right->m_color = Color::Black;
+                    rotate_left(parent);
+                    node = m_root;
+                } else {
+                    Node *sibling = parent->m_left;
+
+                    if (color(sibling) == Color::Red) {
+                        sibling->m_color = Color::Black;
+                        parent->m_color = Color::Red;
+                        rotate_right(parent);
+                        sibling = parent->m_left;
+                    }
+
+                    if (color(sibling->m_left) == Color::Black && color(sibling->m_right) == Color::Black) {
+                        sibling->m_color = Color::Red;
+                        node = parent;
+                        continue;
+                    }
+
+                    if (color(sibling->m_left) == Color::Black) {
+                        sibling->m_right->m_color = Color::Black;
+                        sibling->m_color = Color::Red;
+                        rotate_left(sibling);
+                        sibling = parent->m_left;
+                    }
+
+                    sibling->m_color = parent->m_color;
+                    parent->m_color = Color::Black;
+                    sibling->m_left->m_color = Color::Black;
+                    rotate_right(parent);
+                    node = m_root;
+                }
+            }
 
-            *parent = subtree;
-            return min_impl(subtree->m_left, parent);
+            node->m_color = Color::Black;
         }
 
-        void remove_impl(Node *node, Node *parent)
+        void remove_impl(Node *node)
         {
             ASSERT(node->m_left == nullptr || node->m_right == nullptr);
 
-            if (node->m_left == nullptr && node->m_right == nullptr) {
-                if (parent)
-                    parent->replace_child(node, nullptr);
-                else
-                    m_root = nullptr;
-            } else if (node->m_left == nullptr) {
-                if (parent)
-                    parent->replace_child(node, node->m_right);
-                else
-                    m_root = node->m_right;
+            Node *child = node->m_left != nullptr ? node->m_left : node->m_right;
 
-                node->m_right = nullptr;
+            if (child != nullptr) {
+                // A node with a single child must be black and the child must be red
+                replace_node(node, child);
+                child->m_color = Color::Black;
             } else {
-                if (parent)
-                    parent->replace_child(node, node->m_left);
-                else
-                    m_root = node->m_left;
+                if (node->m_color == Color::Black)
+                    remove_fixup(node);
 
-                node->m_left = nullptr;
+                replace_node(node, nullptr);
             }
 
-            node->m_parent = nullptr;
-            delete node;
+            destroy_node(node);
             --m_size;
         }
 
+        template<typename T_>
+        Node* create_node(T_&& value)
+        {
+            return new (m_allocator.allocate(sizeof(Node))) Node { forward<T_>(value) };
+        }
+
+        void destroy_node(Node *node)
+        {
+            node->~Node();
+            m_allocator.deallocate(node, sizeof(Node));
+        }
+
+        // The depth is bounded, thus the recursion is as well
+        void destroy_subtree(Node *subtree)
+        {
+            if (subtree == nullptr)
+                return;
+
+            destroy_subtree(subtree->m_left);
+            destroy_subtree(subtree->m_right);
+            destroy_node(subtree);
+        }
+
+        static usize depth_impl(const Node *subtree)
+        {
+            if (subtree == nullptr)
+                return 0;
+
+            return 1 + max(depth_impl(subtree->m_left), depth_impl(subtree->m_right));
+        }
+
+        static usize count_nodes_impl(const Node *subtree)
+        {
+            if (subtree == nullptr)
+                return 0;
+
+            return 1 + count_nodes_impl(subtree->m_left) + count_nodes_impl(subtree->m_right);
+        }
+
+        // Returns the number of black nodes on every path to a leaf.
+        static usize verify_invariants_impl(const Node *subtree)
+        {
+            if (subtree == nullptr)
+                return 1;
+
+            if (subtree->m_left) {
+                VERIFY(subtree->m_left->m_parent == subtree);
+                VERIFY(subtree->m_left->m_value < subtree->m_value);
+            }
+            if (subtree->m_right) {
+                VERIFY(subtree->m_right->m_parent == subtree);
+                VERIFY(subtree->m_right->m_value > subtree->m_value);
+            }
+
+            if (subtree->m_color == Color::Red) {
+                VERIFY(color(subtree->m_left) == Color::Black);
+                VERIFY(color(subtree->m_right) == Color::Black);
+            }
+
+            usize left_black_height = verify_invariants_impl(subtree->m_left);
+            usize right_black_height = verify_invariants_impl(subtree->m_right);
+            VERIFY(left_black_height == right_black_height);
+
+            return left_black_height + (subtree->m_color == Color::Black ? 1 : 0);
+        }
+
         Node *m_root;
         usize m_size;
+
+        [[no_unique_address]]
+        Allocator m_allocator;
     };
 
-    template<typename T>
-    struct Formatter<SortedSet<T>> {
-        static void format(StringBuilder& builder, const SortedSet<T>& value)
+    template<typename T, typename Allocator>
+    struct Formatter<SortedSet<T, Allocator>> {
+        static void format(StringBuilder& builder, const SortedSet<T, Allocator>& value)
         {
             return value.dump(builder);
         }
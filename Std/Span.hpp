@@ -41,17 +41,15 @@ namespace Std {
         {
             VERIFY(other.size() >= size());
 
-            for (usize index = 0; index < size(); ++index)
-                other[index] = (*this)[index];
-
-            return other.size();
+            copy_elements(other.data(), size());
+            return size();
         }
 
         usize copy_trimmed_to(Span<typename RemoveConst<T>::Type> other) const
         {
             usize count = min(size(), other.size());
 
-            memcpy(other.data(), data(), count);
+            copy_elements(other.data(), count);
             return count;
         }
 
@@ -78,6 +76,17 @@ namespace Std {
         SpanIterator<T> iter();
 
     private:
+        void copy_elements(typename RemoveConst<T>::Type *destination, usize count) const
+        {
+            if constexpr (Concepts::TriviallyCopyable<T>) {
+                if (count > 0)
+                    memcpy(destination, data(), count * sizeof(T));
+            } else {
+                for (usize index = 0; index < count; ++index)
+                    destination[index] = data()[index];
+            }
+        }
+
         T *m_data;
         usize m_size;
     };
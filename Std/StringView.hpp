@@ -2,6 +2,7 @@
 
 #include <Std/Span.hpp>
 #include <Std/Optional.hpp>
+#include <Std/ByteSearch.hpp>
 
 namespace Std {
 
@@ -23,29 +24,34 @@ public:
     {
     }
 
-    Optional<usize> index_of(char ch)
+    Optional<usize> index_of(char ch) const
     {
-        char *pointer = __builtin_strchr(data(), ch);
-
-        if (pointer == nullptr)
-            return {};
+        return find_byte(data(), size(), ch);
+    }
+    Optional<usize> index_of(StringView needle) const
+    {
+        return find_bytes(data(), size(), needle.data(), needle.size());
+    }
 
-        return pointer - data();
+    // Offset of the first character that is one of 'characters'.
+    Optional<usize> index_of_any(StringView characters) const
+    {
+        return find_any_of(data(), size(), characters.data(), characters.size());
     }
 
-    StringView substr(usize index)
+    StringView substr(usize index) const
     {
         VERIFY(index <= size());
         return { data() + index, size() - index };
     }
-    StringView substr(usize start, usize end)
+    StringView substr(usize start, usize end) const
     {
         VERIFY(start <= end);
         VERIFY(end <= size());
         return { data() + start, end - start };
     }
 
-    StringView trim(usize size)
+    StringView trim(usize size) const
     {
         size = min(this->size(), size);
         return { data(), size };
@@ -72,7 +78,7 @@ public:
         if (size() > rhs.size())
             return 1;
 
-        return __builtin_memcmp(data(), rhs.data(), size());
+        return compare_bytes(data(), rhs.data(), size());
     }
 
     // FIXME: The compiler should be able to deduce this?
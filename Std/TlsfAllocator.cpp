@@ -0,0 +1,149 @@
+#include <Std/TlsfAllocator.hpp>
+#include <Std/Format.hpp>
+
+namespace Std
+{
+    // Index of the most significant bit that is set
+    static inline usize highest_bit(usize value)
+    {
+        return sizeof(unsigned long) * 8 - 1 - usize(__builtin_clzl(value));
+    }
+
+    // Index of the least significant bit that is set
+    static inline usize lowest_bit(u32 value)
+    {
+        return usize(__builtin_ctz(value));
+    }
+
+    TlsfAllocator::TlsfAllocator(Bytes heap)
+        : BoundaryTagAllocator(heap)
+    {
+        free_initial_block();
+    }
+
+    usize TlsfAllocator::free_block_size_for(usize size)
+    {
+        if (size >= small_block_size)
+            size += usize(1) << (highest_bit(size) - second_level_log2);
+
+        return size;
+    }
+
+    TlsfAllocator::Index TlsfAllocator::index_for(usize size)
+    {
+        if (size < small_block_size)
+            return { 0, size >> alignment_log2 };
+
+        // The bits below the most significant bit select the list in the second level
+        usize bit = highest_bit(size);
+        usize second = (size >> (bit - second_level_log2)) ^ second_level_count;
+
+        return { bit - first_level_shift + 1, second };
+    }
+
+    TlsfAllocator::Node* TlsfAllocator::find_free_block(usize size)
+    {
+        // Every block in the list is at least as large as the rounded size, thus the first block of the list fits
+        if (size >= small_block_size)
+            size += (usize(1) << (highest_bit(size) - second_level_log2)) - 1;
+
+        if (highest_bit(size) >= max_block_size_log2)
+            return nullptr;
+
+        auto [first, second] = index_for(size);
+
+        u32 second_level_bitmap = m_second_level_bitmaps[first] & (~0u << second);
+        if (second_level_bitmap == 0) {
+            u32 first_level_bitmap = m_first_level_bitmap & (~0u << (first + 1));
+            if (first_level_bitmap == 0)
+                return nullptr;
+
+            first = lowest_bit(first_level_bitmap);
+            second_level_bitmap = m_second_level_bitmaps[first];
+        }
+
+        return m_free_lists[first][lowest_bit(second_level_bitmap)];
+    }
+
+    void TlsfAllocator::link_free_block(Node *node)
+    {
+        auto [first, second] = index_for(block_size(node));
+        Node *&head = m_free_lists[first][second];
+
+        node->m_previous = nullptr;
+        node->m_next = head;
+
+        if (head != nullptr)
+            head->m_previous = node;
+        head = node;
+
+        m_first_level_bitmap |= 1u << first;
+        m_second_level_bitmaps[first] |= 1u << second;
+    }
+
+    void TlsfAllocator::unlink_free_block(Node *node)
+    {
+        auto [first, second] = index_for(block_size(node));
+
+        if (node->m_previous != nullptr)
+            node->m_previous->m_next = node->m_next;
+        else
+            m_free_lists[first][second] = node->m_next;
+
+        if (node->m_next != nullptr)
+            node->m_next->m_previous = node->m_previous;
+
+        if (m_free_lists[first][second] == nullptr) {
+            m_second_level_bitmaps[first] &= ~(1u << second);
+
+            if (m_second_level_bitmaps[first] == 0)
+                m_first_level_bitmap &= ~(1u << first);
+        }
+    }
+
+    u8* TlsfAllocator::try_allocate(usize size)
+    {
+        usize needed = block_size_for(size);
+
+        Node *node = find_free_block(needed);
+        if (node == nullptr)
+            return nullptr;
+
+        return allocate_block(node, needed);
+    }
+
+    bool TlsfAllocator::try_reallocate_in_place(u8 *pointer, usize size)
+    {
+        VERIFY(pointer != nullptr);
+
+        return try_resize_block(node_of(pointer), size);
+    }
+
+    void TlsfAllocator::check_free_blocks(usize free_count)
+    {
+        // Every free block is in the list for its size and the bitmaps match the lists
+        usize list_count = 0;
+        for (usize first = 0; first < first_level_count; ++first) {
+            for (usize second = 0; second < second_level_count; ++second) {
+                Node *head = m_free_lists[first][second];
+
+                VERIFY(bool(m_second_level_bitmaps[first] & (1u << second)) == (head != nullptr));
+                VERIFY(head == nullptr || head->m_previous == nullptr);
+
+                for (Node *entry = head; entry; entry = entry->m_next) {
+                    VERIFY(is_free(entry));
+                    VERIFY(contains(reinterpret_cast<u8*>(entry)));
+
+                    auto index = index_for(block_size(entry));
+                    VERIFY(index.m_first == first && index.m_second == second);
+
+                    ++list_count;
+                    VERIFY(list_count <= free_count);
+                }
+            }
+
+            VERIFY(bool(m_first_level_bitmap & (1u << first)) == (m_second_level_bitmaps[first] != 0));
+        }
+        VERIFY(list_count == free_count);
+    }
+}
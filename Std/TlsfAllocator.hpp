@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Std/Span.hpp>
+#include <Std/Format.hpp>
+#include <Std/BoundaryTagAllocator.hpp>
+
+namespace Std
+{
+    // Two-Level Segregated Fit: free blocks are kept in lists by size, the first level splits by powers of two and
+    // the second level splits every power of two linearly.  Bitmaps record which lists are non-empty, thus a
+    // suitable block is found with two bit scans and allocate and deallocate take constant time.  The price is
+    // that a request is rounded up to the next list boundary, at most 1/16 of its size is wasted this way.
+    //
+    // The blocks and the regions of the heap are implemented in 'BoundaryTagAllocator' like in 'MemoryAllocator',
+    // free neighbours are merged immediately.
+    class TlsfAllocator : public BoundaryTagAllocator<TlsfAllocator> {
+    public:
+        explicit TlsfAllocator(Bytes heap);
+
+        // Returns null instead of crashing if the heap is exhausted, this is not traced.
+        u8* try_allocate(usize);
+
+        // Resizes the block without moving it, returns false if it can not grow into the following memory.  If the
+        // block shrinks by a quarter or more, the tail is returned to the free lists.
+        bool try_reallocate_in_place(u8*, usize);
+
+        // The number of bytes that can be used in the block, this may be more than was requested.
+        static usize usable_size(u8 *pointer) { return usable_size(node_of(pointer)); }
+        using BoundaryTagAllocator::usable_size;
+
+        void dump()
+        {
+            dbgln("free lists:");
+            for (usize first = 0; first < first_level_count; ++first) {
+                for (usize second = 0; second < second_level_count; ++second) {
+                    for (auto *entry = m_free_lists[first][second]; entry; entry = entry->m_next)
+                        dbgln("  [{}][{}] {} ({} bytes)", first, second, entry, usable_size(entry));
+                }
+            }
+
+            auto stats = statistics();
+
+            dbgln("statistics:");
+            dbgln("  m_largest_continous_block {}", stats.m_largest_continous_block);
+            dbgln("  m_avaliable_memory        {}", stats.m_avaliable_memory);
+        }
+
+        Statistics statistics()
+        {
+            Statistics stats;
+
+            stats.m_largest_continous_block = 0;
+            stats.m_avaliable_memory = 0;
+            stats.m_size_class_memory = 0;
+
+            for (usize first = 0; first < first_level_count; ++first) {
+                for (usize second = 0; second < second_level_count; ++second) {
+                    for (auto *entry = m_free_lists[first][second]; entry; entry = entry->m_next) {
+                        stats.m_avaliable_memory += usable_size(entry);
+
+                        if (usable_size(entry) > stats.m_largest_continous_block)
+                            stats.m_largest_continous_block = usable_size(entry);
+                    }
+                }
+            }
+
+            return stats;
+        }
+
+    private:
+        friend BoundaryTagAllocator;
+
+        static constexpr usize alignment_log2 = sizeof(usize) == 8 ? 3 : 2;
+        static_assert(usize(1) << alignment_log2 == alignment);
+
+        // Each power of two is split into this many lists
+        static constexpr usize second_level_log2 = 4;
+        static constexpr usize second_level_count = 1 << second_level_log2;
+
+        // Blocks below this size are all kept in the first row, in lists that are 'alignment' bytes apart
+        static constexpr usize first_level_shift = second_level_log2 + alignment_log2;
+        static constexpr usize small_block_size = 1 << first_level_shift;
+
+        // The largest heap is 16 MiB on the device, the bitmap of the first level must fit into a word.  Blocks
+        // must be smaller than '1 << max_block_size_log2', the last list starts at half of that.
+        static constexpr usize max_block_size_log2 = sizeof(usize) == 8 ? 32 : 24;
+        static constexpr usize first_level_count = max_block_size_log2 - first_level_shift + 1;
+        static constexpr usize max_block_size = (usize(1) << max_block_size_log2) - 1;
+
+        static_assert(first_level_count < 32);
+
+        struct Index {
+            usize m_first;
+            usize m_second;
+        };
+
+        // The list that holds free blocks of this size
+        static Index index_for(usize size);
+
+        // Finds a free block that is at least 'size' bytes large, or returns null
+        Node* find_free_block(usize size);
+
+        void link_free_block(Node*);
+        void unlink_free_block(Node*);
+
+        void deallocate_block(u8 *pointer) { free_block(node_of(pointer)); }
+
+        // A free block of this size is in a list above the rounded size, see 'find_free_block'
+        static usize free_block_size_for(usize size);
+
+        void check_free_blocks(usize free_count);
+
+        // Bit 'first' is set if any list in 'm_second_level_bitmaps[first]' is non-empty
+        u32 m_first_level_bitmap = 0;
+        u32 m_second_level_bitmaps[first_level_count] = {};
+
+        Node *m_free_lists[first_level_count][second_level_count] = {};
+    };
+}
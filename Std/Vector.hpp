@@ -1,17 +1,19 @@
 #pragma once
 
 #include <Std/Forward.hpp>
+#include <Std/Allocator.hpp>
 #include <Std/Span.hpp>
 #include <Std/Concepts.hpp>
+#include <Std/Relocate.hpp>
 
 namespace Std
 {
-    template<typename T, usize InlineSize = 0>
+    template<typename T, usize InlineSize = 0, typename Allocator = HeapAllocator>
     class Vector {
     public:
-        Vector()
+        Vector(Allocator allocator = {})
+            : m_allocator(allocator)
         {
-            m_use_inline_data = true;
             m_size = 0;
             m_capacity = InlineSize;
             m_data = nullptr;
@@ -19,29 +21,27 @@ namespace Std
         ~Vector()
         {
             clear();
-
-            operator delete[](m_data);
-            m_data = nullptr;
+            deallocate();
         }
         Vector(const Vector& other)
-            : Vector()
+            : Vector(other.m_allocator)
         {
             *this = other;
         }
         Vector(Vector&& other)
-            : Vector()
+            : Vector(other.m_allocator)
         {
             *this = move(other);
         }
 
         T& append(const T& value)
         {
-            ensure_capacity(m_size + 1);
+            if (m_size < m_capacity)
+                return *new (data() + m_size++) T { value };
 
-            T *pointer = new (data() + m_size) T { value };
-            ++m_size;
-
-            return *pointer;
+            // The value could be part of this vector
+            T copy { value };
+            return append(move(copy));
         }
         T& append(T&& value)
         {
@@ -55,52 +55,127 @@ namespace Std
 
         void extend(Span<const T> values)
         {
+            insert(m_size, values);
+        }
+
+        T& insert(usize index, const T& value)
+        {
+            T copy { value };
+            return insert(index, move(copy));
+        }
+        T& insert(usize index, T&& value)
+        {
+            VERIFY(index <= m_size);
+
+            ensure_capacity(m_size + 1);
+            make_gap(index, 1);
+
+            T *pointer = new (data() + index) T { move(value) };
+            ++m_size;
+
+            return *pointer;
+        }
+        void insert(usize index, Span<const T> values)
+        {
+            VERIFY(index <= m_size);
+
+            // Growing would invalidate 'values' if they are part of this vector
+            ASSERT(values.data() + values.size() <= data() || values.data() >= data() + m_capacity);
+
             ensure_capacity(m_size + values.size());
+            make_gap(index, values.size());
+
+            if constexpr (Concepts::TriviallyCopyable<T>) {
+                if (values.size() > 0)
+                    memcpy(data() + index, values.data(), values.size() * sizeof(T));
+            } else {
+                for (usize offset = 0; offset < values.size(); ++offset)
+                    new (data() + index + offset) T { values.data()[offset] };
+            }
+
+            m_size += values.size();
+        }
+
+        void erase(usize index, usize count = 1)
+        {
+            VERIFY(index + count <= m_size);
+
+            if constexpr (Concepts::TriviallyRelocatable<T>) {
+                for (usize offset = 0; offset < count; ++offset)
+                    data()[index + offset].~T();
 
-            for (auto& value : values.iter())
-                append(value);
+                if (index + count < m_size)
+                    relocate_overlapping(data() + index, data() + index + count, m_size - index - count);
+            } else {
+                for (usize target = index; target + count < m_size; ++target)
+                    data()[target] = move(data()[target + count]);
+
+                for (usize target = m_size - count; target < m_size; ++target)
+                    data()[target].~T();
+            }
+
+            m_size -= count;
         }
 
+        // Grows to the next power of two that can hold 'new_capacity' elements.
         void ensure_capacity(usize new_capacity)
         {
             if (m_capacity >= new_capacity)
                 return;
 
-            new_capacity = round_to_power_of_two(new_capacity);
-
-            T *new_data = reinterpret_cast<T*>(new u8[sizeof(T) * new_capacity]);
-            ASSERT(new_data != nullptr);
+            reallocate(round_to_power_of_two(new_capacity));
+        }
 
-            ASSERT(new_capacity > m_size);
+        // Unlike 'ensure_capacity', this allocates exactly the requested capacity.
+        void reserve(usize new_capacity)
+        {
+            if (m_capacity >= new_capacity)
+                return;
 
-            if constexpr (Concepts::Primitive<T>) {
-                memcpy(new_data, data(), m_size * sizeof(T));
-            } else {
-                // Otherwise, we will get misaligned read/write problems here
-                ASSERT(sizeof(T) % 4 == 0);
+            reallocate(new_capacity);
+        }
 
-                for (usize i = 0; i < m_size; ++ i) {
-                    new (new_data + i) T { move(data()[i]) };
-                    data()[i].~T();
-                }
-            }
+        // Tries to provide room for 'new_capacity' elements without moving the existing elements.
+        bool try_grow(usize new_capacity)
+        {
+            if (m_capacity >= new_capacity)
+                return true;
 
-            operator delete[](m_data);
+            if (m_data == nullptr || !m_allocator.try_reallocate_in_place(m_data, m_capacity * sizeof(T), new_capacity * sizeof(T)))
+                return false;
 
-            m_data = new_data;
             m_capacity = new_capacity;
-            m_use_inline_data = false;
+            return true;
+        }
+
+        void shrink_to_fit()
+        {
+            if (m_data == nullptr || m_capacity == m_size)
+                return;
+
+            if (m_size <= InlineSize) {
+                T *old_data = m_data;
+                usize old_capacity = m_capacity;
+
+                m_data = nullptr;
+                m_capacity = InlineSize;
+
+                relocate(data(), old_data, m_size);
+                m_allocator.deallocate(old_data, sizeof(T) * old_capacity);
+            } else {
+                reallocate(m_size);
+            }
         }
 
         const T* data() const
         {
-            if (m_use_inline_data)
+            if (m_data == nullptr)
                 return reinterpret_cast<const T*>(m_inline_data);
             return m_data;
         }
         T* data()
         {
-            if (m_use_inline_data)
+            if (m_data == nullptr)
                 return reinterpret_cast<T*>(m_inline_data);
             return m_data;
         }
@@ -127,40 +202,98 @@ namespace Std
 
         Vector& operator=(const Vector& other)
         {
-            clear();
-            extend(other.span());
+            if (this != &other) {
+                clear();
+                extend(other.span());
+            }
+
             return *this;
         }
         Vector& operator=(Vector&& other)
         {
+            if (this == &other)
+                return *this;
+
             clear();
 
-            if (other.m_use_inline_data) {
-                extend(other.span());
-                other.clear();
-            } else {
-                operator delete[](m_data);
+            // Blocks can only be taken over from an allocator that could also free them
+            if (other.m_data == nullptr || !(m_allocator == other.m_allocator)) {
+                ensure_capacity(other.m_size);
 
-                m_use_inline_data = false;
-                m_capacity = other.m_capacity;
-                m_size = other.m_size;
-                m_data = other.m_data;
+                relocate(data(), other.data(), other.m_size);
+                m_size = exchange(other.m_size, 0);
+            } else {
+                deallocate();
 
-                other.m_use_inline_data = true;
-                other.m_capacity = InlineSize;
-                other.m_size = 0;
-                other.m_data = nullptr;
+                m_capacity = exchange(other.m_capacity, InlineSize);
+                m_size = exchange(other.m_size, 0);
+                m_data = exchange(other.m_data, nullptr);
             }
 
             return *this;
         }
 
     private:
-        bool m_use_inline_data;
+        // Shifts the elements starting at 'index' back by 'count' elements; there must be enough capacity.
+        void make_gap(usize index, usize count)
+        {
+            if (index == m_size || count == 0)
+                return;
+
+            if constexpr (Concepts::TriviallyRelocatable<T>) {
+                relocate_overlapping(data() + index + count, data() + index, m_size - index);
+            } else {
+                for (usize source = m_size; source-- > index;) {
+                    new (data() + source + count) T { move(data()[source]) };
+                    data()[source].~T();
+                }
+            }
+        }
+
+        void reallocate(usize new_capacity)
+        {
+            ASSERT(new_capacity >= m_size);
+
+            if (new_capacity > m_capacity && try_grow(new_capacity))
+                return;
+
+            T *new_data;
+            if (Concepts::TriviallyRelocatable<T> && m_data != nullptr) {
+                new_data = reinterpret_cast<T*>(m_allocator.reallocate(m_data, sizeof(T) * m_capacity, sizeof(T) * new_capacity));
+                ASSERT(new_data != nullptr);
+            } else {
+                new_data = reinterpret_cast<T*>(m_allocator.allocate(sizeof(T) * new_capacity));
+                ASSERT(new_data != nullptr);
+
+                relocate(new_data, data(), m_size);
+                deallocate();
+            }
+
+            m_data = new_data;
+            m_capacity = new_capacity;
+        }
+
+        void deallocate()
+        {
+            if (m_data != nullptr)
+                m_allocator.deallocate(m_data, sizeof(T) * m_capacity);
+
+            m_data = nullptr;
+        }
+
         usize m_size;
         usize m_capacity;
 
-        u8 m_inline_data[sizeof(T) * InlineSize];
+        // Points to the heap allocation, the inline storage is used if this is null
         T *m_data;
+
+        [[no_unique_address]]
+        Allocator m_allocator;
+
+        alignas(T) u8 m_inline_data[sizeof(T) * InlineSize];
+    };
+
+    template<typename T, usize InlineSize, typename Allocator>
+    struct IsTriviallyRelocatable<Vector<T, InlineSize, Allocator>> : IntegralConstant<bool, IsTriviallyRelocatable<T>::value> {
     };
 }
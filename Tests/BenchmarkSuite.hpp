@@ -0,0 +1,114 @@
+#pragma once
+
+// Otherwise IntelliSense will be incorrect.
+#ifndef TEST
+# warning "TEST not defined"
+# define TEST
+#endif
+
+#include <Std/Forward.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include <cstdio>
+
+namespace Benchmarks
+{
+    using BenchmarkFunction = std::function<void()>;
+
+    struct BenchmarkCase;
+
+    std::vector<BenchmarkCase*>& benchmarks();
+
+    struct BenchmarkCase
+    {
+        BenchmarkCase(const char *name, const char *file, size_t line, BenchmarkFunction func)
+            : m_name(name)
+            , m_file(file)
+            , m_line(line)
+            , m_func(func)
+        {
+            benchmarks().push_back(this);
+        }
+
+        const char *m_name;
+        const char *m_file;
+        size_t m_line;
+        BenchmarkFunction m_func;
+    };
+
+    inline std::vector<BenchmarkCase*>& benchmarks()
+    {
+        static std::vector<BenchmarkCase*> benchmarks;
+        return benchmarks;
+    }
+
+    inline void run()
+    {
+        for (auto *benchmark : benchmarks())
+        {
+            std::cout << "Running benchmark '" << benchmark->m_name << "' (" << benchmark->m_file << ":" << benchmark->m_line << ")\n";
+            std::cout.flush();
+
+            benchmark->m_func();
+
+            std::cout << "\n";
+        }
+    }
+
+    // Prevents the compiler from discarding a computation whose result would otherwise be unused.
+    template<typename T>
+    void do_not_optimize(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // Runs 'callback' until at least 'min_duration' passed and returns the average time per run in nanoseconds.
+    template<typename Callback>
+    double measure(Callback&& callback, std::chrono::nanoseconds min_duration = std::chrono::milliseconds(20))
+    {
+        using Clock = std::chrono::steady_clock;
+
+        usize runs = 0;
+        auto start = Clock::now();
+        auto end = start;
+
+        // Reading the clock is not free, run the callback in growing batches in between
+        usize batch_size = 1;
+        do {
+            for (usize index = 0; index < batch_size; ++index)
+                callback();
+
+            runs += batch_size;
+            end = Clock::now();
+
+            if (batch_size < 1024)
+                batch_size *= 2;
+        } while (end - start < min_duration);
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / double(runs);
+    }
+
+    // Measures a single run, used for operations that can not be repeated without setup.
+    template<typename Callback>
+    double measure_once(Callback&& callback)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        auto start = Clock::now();
+        callback();
+        auto end = Clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+}
+
+#define BENCHMARK_CASE(name) \
+    void __benchmark_func_##name(); \
+    ::Benchmarks::BenchmarkCase __benchmark_case_##name { #name, __FILE__, __LINE__, __benchmark_func_##name }; \
+    void __benchmark_func_##name()
+
+#define BENCHMARK_MAIN() \
+    int main(int argc, char **argv) { ::Benchmarks::run(); }
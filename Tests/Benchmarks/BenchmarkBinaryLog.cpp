@@ -0,0 +1,56 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/BinaryLog.hpp>
+
+#include <cstdio>
+
+static usize record_size;
+
+void Std::dbgln_binary_raw(ReadonlyBytes record)
+{
+    record_size = record.size();
+    Benchmarks::do_not_optimize(record.data());
+}
+
+// Compares what a typical kernel message costs on the device: formatting the text versus encoding a record.
+BENCHMARK_CASE(posix_spawn_message)
+{
+    u32 pid = 42;
+    u32 address = 0x20001234;
+    const char *name = "Shell.elf";
+
+    usize text_size = 0;
+    double text_ns = Benchmarks::measure([&] {
+        Std::StringBuilder builder;
+        builder.appendf("[Process::sys$posix_spawn] Created new process PID {} running {} at {}", pid, name, address);
+        text_size = builder.size();
+        Benchmarks::do_not_optimize(builder.data());
+    });
+
+    double binary_ns = Benchmarks::measure([&] {
+        dbgln("[Process::sys$posix_spawn] Created new process PID {} running {} at {}", pid, name, address);
+    });
+
+    printf("  text %6.1f ns %3zu bytes  binary %6.1f ns %3zu bytes\n", text_ns, text_size, binary_ns, record_size);
+}
+
+BENCHMARK_CASE(integer_message)
+{
+    u32 values[3] = { 1, 0x2000, 0x20040000 };
+
+    usize text_size = 0;
+    double text_ns = Benchmarks::measure([&] {
+        Std::StringBuilder builder;
+        builder.appendf("[PageAllocator::deallocate] power={:d} base={} size={}", values[0], values[1], values[2]);
+        text_size = builder.size();
+        Benchmarks::do_not_optimize(builder.data());
+    });
+
+    double binary_ns = Benchmarks::measure([&] {
+        dbgln("[PageAllocator::deallocate] power={:d} base={} size={}", values[0], values[1], values[2]);
+    });
+
+    printf("  text %6.1f ns %3zu bytes  binary %6.1f ns %3zu bytes\n", text_ns, text_size, binary_ns, record_size);
+}
+
+BENCHMARK_MAIN();
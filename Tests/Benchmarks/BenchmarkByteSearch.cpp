@@ -0,0 +1,110 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/ByteSearch.hpp>
+#include <Std/Lexer.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// The previous scans looked at one character at a time
+[[gnu::noinline]]
+static Std::Optional<usize> find_byte_bytewise(const char *data, usize size, char needle)
+{
+    for (usize offset = 0; offset < size; ++offset) {
+        if (data[offset] == needle)
+            return offset;
+    }
+    return {};
+}
+
+[[gnu::noinline]]
+static int compare_bytewise(const char *lhs, const char *rhs, usize size)
+{
+    for (usize offset = 0; offset < size; ++offset) {
+        if (lhs[offset] != rhs[offset])
+            return int(u8(lhs[offset])) - int(u8(rhs[offset]));
+    }
+    return 0;
+}
+
+// The needle is at the end, the whole input is scanned
+BENCHMARK_CASE(find_byte)
+{
+    for (usize size : { 8, 16, 64, 1024, 16 * 1024 }) {
+        std::string input(size - 1, 'a');
+        input.push_back('/');
+
+        double bytewise_ns = Benchmarks::measure([&] {
+            Benchmarks::do_not_optimize(find_byte_bytewise(input.data(), input.size(), '/'));
+        });
+        double swar_ns = Benchmarks::measure([&] {
+            Benchmarks::do_not_optimize(Std::find_byte(input.data(), input.size(), '/'));
+        });
+        double memchr_ns = Benchmarks::measure([&] {
+            Benchmarks::do_not_optimize(memchr(input.data(), '/', input.size()));
+        });
+
+        printf("  %6zu bytes: bytewise %7.2f GB/s  word %7.2f GB/s  memchr %7.2f GB/s\n",
+            size, double(size) / bytewise_ns, double(size) / swar_ns, double(size) / memchr_ns);
+    }
+}
+
+BENCHMARK_CASE(find_any_of)
+{
+    for (usize size : { 16, 1024 }) {
+        std::string input(size - 1, 'a');
+        input.push_back('\n');
+
+        double strcspn_ns = Benchmarks::measure([&] {
+            Benchmarks::do_not_optimize(strcspn(input.c_str(), " \t\n"));
+        });
+        double swar_ns = Benchmarks::measure([&] {
+            Benchmarks::do_not_optimize(Std::find_any_of(input.data(), input.size(), " \t\n", 3));
+        });
+
+        printf("  %6zu bytes: word %7.2f GB/s  strcspn %7.2f GB/s\n", size, double(size) / swar_ns, double(size) / strcspn_ns);
+    }
+}
+
+BENCHMARK_CASE(compare_bytes)
+{
+    for (usize size : { 8, 64, 1024 }) {
+        std::string lhs(size, 'a');
+        std::string rhs = lhs;
+        rhs.back() = 'b';
+
+        double bytewise_ns = Benchmarks::measure([&] {
+            Benchmarks::do_not_optimize(compare_bytewise(lhs.data(), rhs.data(), size));
+        });
+        double swar_ns = Benchmarks::measure([&] {
+            Benchmarks::do_not_optimize(Std::compare_bytes(lhs.data(), rhs.data(), size));
+        });
+
+        printf("  %6zu bytes: bytewise %7.2f GB/s  word %7.2f GB/s\n", size, double(size) / bytewise_ns, double(size) / swar_ns);
+    }
+}
+
+// Splits a typical environment into lines, like a shell or the loader would
+BENCHMARK_CASE(lexer_consume_until)
+{
+    std::string input;
+    for (usize index = 0; index < 32; ++index)
+        input += "VARIABLE_" + std::to_string(index) + "=/usr/local/bin:/usr/bin:/bin\n";
+
+    double ns = Benchmarks::measure([&] {
+        Std::Lexer lexer { Std::StringView { input.data(), input.size() } };
+
+        usize count = 0;
+        while (!lexer.eof()) {
+            Benchmarks::do_not_optimize(lexer.consume_until('\n'));
+            lexer.try_consume('\n');
+            ++count;
+        }
+        Benchmarks::do_not_optimize(count);
+    });
+
+    printf("  %zu bytes in %.1f ns, %.2f GB/s\n", input.size(), ns, double(input.size()) / ns);
+}
+
+BENCHMARK_MAIN();
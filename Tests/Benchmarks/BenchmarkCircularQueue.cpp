@@ -0,0 +1,77 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/CircularQueue.hpp>
+
+#include <deque>
+
+// Alternates between filling and draining the queue, which is how the scheduler uses its run queue.
+template<typename Queue>
+static void fill_and_drain(Queue& queue, usize count)
+{
+    for (usize index = 0; index < count; ++index)
+        queue.enqueue(int(index));
+
+    for (usize index = 0; index < count; ++index)
+        Benchmarks::do_not_optimize(queue.dequeue());
+}
+
+static constexpr usize sizes[] = { 4, 16, 256, 4096 };
+
+BENCHMARK_CASE(fill_and_drain)
+{
+    for (usize size : sizes) {
+        double deque_ns = Benchmarks::measure([&] {
+            std::deque<int> queue;
+
+            for (usize index = 0; index < size; ++index)
+                queue.push_back(int(index));
+
+            for (usize index = 0; index < size; ++index) {
+                Benchmarks::do_not_optimize(queue.front());
+                queue.pop_front();
+            }
+        });
+
+        double fresh_ns = Benchmarks::measure([&] {
+            Std::GrowableCircularQueue<int> queue;
+            fill_and_drain(queue, size);
+        });
+
+        Std::GrowableCircularQueue<int> reused_queue;
+        double reused_ns = Benchmarks::measure([&] {
+            fill_and_drain(reused_queue, size);
+        });
+
+        printf("  %4zu elements: std::deque %8.1f ns  growable %8.1f ns  growable (warm) %8.1f ns\n",
+            size_t(size), deque_ns, fresh_ns, reused_ns);
+    }
+}
+
+BENCHMARK_CASE(rotate)
+{
+    // The scheduler dequeues a thread and enqueues it again at every context switch
+    for (usize size : sizes) {
+        Std::CircularQueue<int, 4096> fixed_queue;
+        Std::GrowableCircularQueue<int> growable_queue;
+
+        for (usize index = 0; index < size; ++index) {
+            fixed_queue.enqueue(int(index));
+            growable_queue.enqueue(int(index));
+        }
+
+        double fixed_ns = Benchmarks::measure([&] {
+            fixed_queue.enqueue(fixed_queue.dequeue());
+            Benchmarks::do_not_optimize(fixed_queue.back());
+        });
+
+        double growable_ns = Benchmarks::measure([&] {
+            growable_queue.enqueue(growable_queue.dequeue());
+            Benchmarks::do_not_optimize(growable_queue.back());
+        });
+
+        printf("  %4zu elements: fixed (modulo) %6.2f ns  growable (mask) %6.2f ns\n",
+            size_t(size), fixed_ns, growable_ns);
+    }
+}
+
+BENCHMARK_MAIN();
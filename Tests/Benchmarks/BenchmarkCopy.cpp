@@ -0,0 +1,76 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/Span.hpp>
+#include <Std/StringBuilder.hpp>
+
+// The element-wise loops that 'Span::copy_to' and 'StringBuilder::append' used previously, kept here for comparison.
+[[gnu::noinline]]
+static void copy_elementwise(Std::ReadonlyBytes source, Std::Bytes destination)
+{
+    for (usize index = 0; index < source.size(); ++index)
+        destination[index] = source[index];
+}
+
+[[gnu::noinline]]
+static void append_elementwise(Std::StringBuilder& builder, Std::StringView value)
+{
+    for (char ch : value.iter())
+        builder.append(ch);
+}
+
+static double gigabytes_per_second(usize bytes, double nanoseconds)
+{
+    return double(bytes) / nanoseconds;
+}
+
+static constexpr usize sizes[] = { 1, 4, 16, 64, 256, 1024, 4096 };
+
+BENCHMARK_CASE(span_copy_to)
+{
+    std::vector<u8> source(4096, 0x55);
+    std::vector<u8> destination(4096);
+
+    for (usize size : sizes) {
+        Std::ReadonlyBytes source_bytes { source.data(), size };
+        Std::Bytes destination_bytes { destination.data(), size };
+
+        double before_ns = Benchmarks::measure([&] {
+            copy_elementwise(source_bytes, destination_bytes);
+            Benchmarks::do_not_optimize(destination.data());
+        });
+
+        double after_ns = Benchmarks::measure([&] {
+            source_bytes.copy_to(destination_bytes);
+            Benchmarks::do_not_optimize(destination.data());
+        });
+
+        printf("  %4zu bytes: element-wise %6.2f GB/s  copy_to %6.2f GB/s\n",
+            size_t(size), gigabytes_per_second(size, before_ns), gigabytes_per_second(size, after_ns));
+    }
+}
+
+BENCHMARK_CASE(stringbuilder_append)
+{
+    std::string source(4096, 'x');
+
+    for (usize size : sizes) {
+        Std::StringView view { source.data(), size };
+
+        double before_ns = Benchmarks::measure([&] {
+            Std::StringBuilder builder;
+            append_elementwise(builder, view);
+            Benchmarks::do_not_optimize(builder.data());
+        });
+
+        double after_ns = Benchmarks::measure([&] {
+            Std::StringBuilder builder;
+            builder.append(view);
+            Benchmarks::do_not_optimize(builder.data());
+        });
+
+        printf("  %4zu bytes: element-wise %6.2f GB/s  append %6.2f GB/s\n",
+            size_t(size), gigabytes_per_second(size, before_ns), gigabytes_per_second(size, after_ns));
+    }
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,142 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/Format.hpp>
+#include <Std/Lexer.hpp>
+
+#include <cstdio>
+
+// The previous implementation lexed the format string at runtime, dispatched through function pointers and
+// appended integers digit by digit; a reduced copy is kept here for comparison.
+namespace Legacy
+{
+    using FormatFunction = void(*)(Std::StringBuilder&, const void*);
+
+    struct Parameter {
+        const void *m_value;
+        FormatFunction m_format;
+    };
+
+    template<typename T>
+    void format_integer(Std::StringBuilder& builder, const void *pointer)
+    {
+        T value = *reinterpret_cast<const T*>(pointer);
+
+        builder.append("0x");
+
+        char buffer[sizeof(T) * 2];
+        for (usize index = 0; index < sizeof(buffer); ++index) {
+            buffer[index] = "0123456789abcdef"[value % 16];
+            value /= 16;
+        }
+
+        for (usize index = 0; index < sizeof(buffer); ++index)
+            builder.append(buffer[(sizeof(buffer) - 1) - index]);
+    }
+
+    void format_string(Std::StringBuilder& builder, const void *pointer)
+    {
+        builder.append(*reinterpret_cast<const char* const*>(pointer));
+    }
+
+    [[gnu::noinline]]
+    void vformat(Std::StringBuilder& builder, Std::StringView fmtstr, Std::Span<const Parameter> parameters)
+    {
+        usize next_parameter_index = 0;
+        usize curly_brace_level = 0;
+        Std::Lexer lexer { fmtstr };
+
+        while (!lexer.eof()) {
+            if (curly_brace_level == 0) {
+                if (lexer.try_consume("{{")) {
+                    builder.append('{');
+                    continue;
+                }
+                if (lexer.try_consume("}}")) {
+                    builder.append('}');
+                    continue;
+                }
+                if (lexer.try_consume('{')) {
+                    curly_brace_level = 1;
+                    continue;
+                }
+
+                builder.append(lexer.consume());
+            } else {
+                if (lexer.try_consume('}')) {
+                    --curly_brace_level;
+
+                    auto& parameter = parameters[next_parameter_index++];
+                    parameter.m_format(builder, parameter.m_value);
+                    continue;
+                }
+
+                lexer.consume();
+            }
+        }
+    }
+}
+
+BENCHMARK_CASE(string_format)
+{
+    u32 pid = 42;
+    u32 address = 0x20001234;
+    const char *name = "Shell.elf";
+
+    double legacy_ns = Benchmarks::measure([&] {
+        Legacy::Parameter parameters[] = {
+            { &pid, Legacy::format_integer<u32> },
+            { &name, Legacy::format_string },
+            { &address, Legacy::format_integer<u32> },
+        };
+
+        Std::StringBuilder builder;
+        Legacy::vformat(builder, "[Process::sys$posix_spawn] Created new process PID {} running {} at {}", { parameters, 3 });
+        Benchmarks::do_not_optimize(builder.string());
+    });
+
+    double current_ns = Benchmarks::measure([&] {
+        auto string = Std::String::format("[Process::sys$posix_spawn] Created new process PID {} running {} at {}", pid, name, address);
+        Benchmarks::do_not_optimize(string);
+    });
+
+    double snprintf_ns = Benchmarks::measure([&] {
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "[Process::sys$posix_spawn] Created new process PID 0x%08x running %s at 0x%08x", pid, name, address);
+        Benchmarks::do_not_optimize(buffer);
+    });
+
+    printf("  runtime lexing %6.1f ns  compile-time chunks %6.1f ns  snprintf %6.1f ns\n", legacy_ns, current_ns, snprintf_ns);
+}
+
+BENCHMARK_CASE(integers)
+{
+    u32 values[64];
+    for (usize index = 0; index < 64; ++index)
+        values[index] = u32(index * 0x9e3779b9);
+
+    double legacy_ns = Benchmarks::measure([&] {
+        Std::StringBuilder builder;
+        for (u32 value : values)
+            Legacy::format_integer<u32>(builder, &value);
+        Benchmarks::do_not_optimize(builder.data());
+    });
+
+    double hex_ns = Benchmarks::measure([&] {
+        Std::StringBuilder builder;
+        for (u32 value : values)
+            builder.appendf("{}", value);
+        Benchmarks::do_not_optimize(builder.data());
+    });
+
+    double decimal_ns = Benchmarks::measure([&] {
+        Std::StringBuilder builder;
+        for (u32 value : values)
+            builder.appendf("{:d}", value);
+        Benchmarks::do_not_optimize(builder.data());
+    });
+
+    printf("  per value: digit by digit %5.1f ns  hex pairs %5.1f ns  decimal pairs %5.1f ns\n",
+        legacy_ns / 64, hex_ns / 64, decimal_ns / 64);
+}
+
+BENCHMARK_MAIN();
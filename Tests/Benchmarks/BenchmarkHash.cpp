@@ -0,0 +1,135 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/Hash.hpp>
+#include <Std/String.hpp>
+
+#include <random>
+
+// The byte-at-a-time hash that 'Hash<StringView>' used previously, kept here for comparison.
+static u32 djb2(Std::StringView value)
+{
+    u32 hash = 5381;
+
+    for (char ch : value.iter())
+        hash = ((hash << 5) + hash) + ch;
+
+    return hash;
+}
+
+static u32 murmur3(Std::StringView value)
+{
+    return Std::Hash<Std::StringView>::compute(value);
+}
+
+static std::vector<Std::String> generate_paths(usize count)
+{
+    std::mt19937 generator { 1 };
+
+    const char *directories[] = { "/bin", "/dev", "/etc", "/home/user", "/tmp" };
+    const char *extensions[] = { ".elf", ".txt", "", ".c" };
+
+    std::vector<Std::String> keys;
+    for (usize index = 0; index < count; ++index) {
+        keys.push_back(Std::String::format("{}/file{}{}",
+            Std::StringView { directories[generator() % 5] },
+            index,
+            Std::StringView { extensions[generator() % 4] }));
+    }
+
+    return keys;
+}
+
+// Short names which only differ in a few characters, djb2 maps many of these to the same value.
+static std::vector<Std::String> generate_short_names()
+{
+    const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+    std::vector<Std::String> keys;
+    for (usize first = 0; alphabet[first]; ++first) {
+        for (usize second = 0; alphabet[second]; ++second) {
+            char name[] = { alphabet[first], alphabet[second], 0 };
+            keys.push_back(name);
+        }
+    }
+
+    return keys;
+}
+
+// Counts the keys that land in an already occupied bucket of a table with 'buckets' slots.
+template<typename Callback>
+usize count_bucket_collisions(const std::vector<Std::String>& keys, usize buckets, Callback&& hash)
+{
+    std::vector<bool> occupied(buckets, false);
+
+    usize collisions = 0;
+    for (auto& key : keys) {
+        usize bucket = hash(key.view()) & (buckets - 1);
+
+        if (occupied[bucket])
+            ++collisions;
+        else
+            occupied[bucket] = true;
+    }
+
+    return collisions;
+}
+
+static void report_collisions(const char *label, const std::vector<Std::String>& keys)
+{
+    for (usize buckets : { 256, 4096, 65536 }) {
+        printf("  %-12s %5zu keys in %6zu buckets: djb2 %5zu collisions  murmur3 %5zu collisions\n",
+            label,
+            keys.size(),
+            size_t(buckets),
+            size_t(count_bucket_collisions(keys, buckets, djb2)),
+            size_t(count_bucket_collisions(keys, buckets, murmur3)));
+    }
+}
+
+BENCHMARK_CASE(hash_collisions)
+{
+    report_collisions("paths", generate_paths(2048));
+    report_collisions("short names", generate_short_names());
+}
+
+BENCHMARK_CASE(hash_throughput)
+{
+    for (usize length : { 4, 8, 16, 32, 64, 256 }) {
+        std::vector<Std::String> keys;
+        for (usize index = 0; index < 64; ++index) {
+            std::string key(length, 'a' + index % 26);
+            keys.push_back(Std::StringView { key.data(), key.size() });
+        }
+
+        double djb2_ns = Benchmarks::measure([&] {
+            for (auto& key : keys)
+                Benchmarks::do_not_optimize(djb2(key.view()));
+        }) / keys.size();
+
+        double murmur3_ns = Benchmarks::measure([&] {
+            for (auto& key : keys)
+                Benchmarks::do_not_optimize(murmur3(key.view()));
+        }) / keys.size();
+
+        printf("  %4zu bytes: djb2 %7.1f ns  murmur3 %7.1f ns\n", size_t(length), djb2_ns, murmur3_ns);
+    }
+}
+
+BENCHMARK_CASE(hash_cached)
+{
+    auto keys = generate_paths(64);
+
+    double uncached_ns = Benchmarks::measure([&] {
+        for (auto& key : keys)
+            Benchmarks::do_not_optimize(Std::Hash<Std::StringView>::compute(key.view()));
+    }) / keys.size();
+
+    double cached_ns = Benchmarks::measure([&] {
+        for (auto& key : keys)
+            Benchmarks::do_not_optimize(Std::Hash<Std::String>::compute(key));
+    }) / keys.size();
+
+    printf("  path keys: recomputed %5.1f ns  cached %5.1f ns\n", uncached_ns, cached_ns);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,144 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/HashMap.hpp>
+#include <Std/SortedSet.hpp>
+#include <Std/Format.hpp>
+
+#include <random>
+
+// The tree-backed layout that 'Std::HashMap' used before it switched to open addressing, kept here for comparison.
+template<typename Key, typename Value>
+class TreeMap {
+public:
+    void set(const Key& key, const Value& value)
+    {
+        m_set.insert({ Std::Hash<Key>::compute(key), key, value });
+    }
+
+    Value* get(const Key& key)
+    {
+        Node *node = m_set.search({ Std::Hash<Key>::compute(key), key, {} });
+
+        if (node)
+            return &node->m_value;
+        else
+            return nullptr;
+    }
+
+    void remove(const Key& key)
+    {
+        m_set.remove({ Std::Hash<Key>::compute(key), key, {} });
+    }
+
+private:
+    struct Node {
+        u32 m_hash;
+        Key m_key;
+        Value m_value;
+
+        bool operator<(const Node& other) const
+        {
+            if (m_hash != other.m_hash)
+                return m_hash < other.m_hash;
+
+            return m_key < other.m_key;
+        }
+        bool operator>(const Node& other) const
+        {
+            if (m_hash != other.m_hash)
+                return m_hash > other.m_hash;
+
+            return m_key > other.m_key;
+        }
+    };
+
+    Std::SortedSet<Node> m_set;
+};
+
+template<typename Key>
+std::vector<Key> generate_keys(usize count, u32 seed);
+
+template<>
+std::vector<u32> generate_keys<u32>(usize count, u32 seed)
+{
+    std::mt19937 generator { seed };
+
+    std::vector<u32> keys;
+    for (usize index = 0; index < count; ++index)
+        keys.push_back(generator());
+
+    return keys;
+}
+
+template<>
+std::vector<Std::String> generate_keys<Std::String>(usize count, u32 seed)
+{
+    std::mt19937 generator { seed };
+
+    std::vector<Std::String> keys;
+    for (usize index = 0; index < count; ++index)
+        keys.push_back(Std::String::format("/dev/entry-{}", generator()));
+
+    return keys;
+}
+
+template<typename Map, typename Key>
+void run_map_benchmark(const char *label, usize count)
+{
+    auto keys = generate_keys<Key>(count, 1);
+    auto missing_keys = generate_keys<Key>(count, 2);
+
+    double insert_ns = Benchmarks::measure([&] {
+        Map map;
+        for (auto& key : keys)
+            map.set(key, 1);
+        Benchmarks::do_not_optimize(map);
+    }) / count;
+
+    Map map;
+    for (auto& key : keys)
+        map.set(key, 1);
+
+    double hit_ns = Benchmarks::measure([&] {
+        for (auto& key : keys)
+            Benchmarks::do_not_optimize(map.get(key));
+    }) / count;
+
+    double miss_ns = Benchmarks::measure([&] {
+        for (auto& key : missing_keys)
+            Benchmarks::do_not_optimize(map.get(key));
+    }) / count;
+
+    double remove_ns = Benchmarks::measure([&] {
+        Map map;
+        for (auto& key : keys)
+            map.set(key, 1);
+        for (auto& key : keys)
+            map.remove(key);
+        Benchmarks::do_not_optimize(map);
+    }) / count - insert_ns;
+
+    printf("  %-10s %6zu entries: insert %8.1f ns  hit %8.1f ns  miss %8.1f ns  remove %8.1f ns\n",
+        label, size_t(count), insert_ns, hit_ns, miss_ns, remove_ns);
+}
+
+template<typename Key>
+void run_comparison()
+{
+    for (usize count : { 8, 64, 512, 4096 }) {
+        run_map_benchmark<Std::HashMap<Key, u32>, Key>("HashMap", count);
+        run_map_benchmark<TreeMap<Key, u32>, Key>("TreeMap", count);
+    }
+}
+
+BENCHMARK_CASE(hashmap_u32)
+{
+    run_comparison<u32>();
+}
+
+BENCHMARK_CASE(hashmap_string)
+{
+    run_comparison<Std::String>();
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,285 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/MemoryAllocator.hpp>
+#include <Std/TlsfAllocator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// An allocation of 'm_size' bytes if 'm_size' is non-zero, otherwise the allocation at 'm_slot' is freed.
+struct Operation {
+    usize m_slot;
+    usize m_size;
+};
+
+// Mostly small objects like strings, tree nodes and reference counted objects with the occasional buffer, the
+// number of live objects fluctuates around 'live_count'.
+static std::vector<Operation> generate_small_object_workload(usize operation_count, usize live_count)
+{
+    std::mt19937 prng { 7 };
+    std::vector<Operation> operations;
+
+    std::vector<usize> live_slots;
+    usize next_slot = 0;
+
+    for (usize index = 0; index < operation_count; ++index) {
+        bool allocate = live_slots.size() < live_count / 2 || (live_slots.size() < live_count && prng() % 2 == 0);
+
+        if (allocate) {
+            usize size;
+            switch (prng() % 16) {
+            case 0:
+                size = 256 + prng() % 768;
+                break;
+            case 1:
+            case 2:
+                size = 65 + prng() % 64;
+                break;
+            default:
+                size = 4 + prng() % 60;
+                break;
+            }
+
+            operations.push_back({ next_slot, size });
+            live_slots.push_back(next_slot++);
+        } else {
+            usize index = prng() % live_slots.size();
+
+            operations.push_back({ live_slots[index], 0 });
+            live_slots[index] = live_slots.back();
+            live_slots.pop_back();
+        }
+    }
+
+    for (usize slot : live_slots)
+        operations.push_back({ slot, 0 });
+
+    return operations;
+}
+
+// Replays the operations and returns the statistics at the point where most objects were alive.
+static Std::MemoryAllocator::Statistics replay(Std::Bytes heap, const std::vector<Operation>& operations, usize slot_count, bool use_size_classes)
+{
+    Std::MemoryAllocator allocator { heap };
+    allocator.m_use_size_classes = use_size_classes;
+
+    std::vector<u8*> slots(slot_count);
+    Std::MemoryAllocator::Statistics statistics {};
+
+    usize live_count = 0;
+    usize peak_live_count = 0;
+
+    for (auto& operation : operations) {
+        if (operation.m_size != 0) {
+            slots[operation.m_slot] = allocator.allocate(operation.m_size, false);
+
+            if (++live_count > peak_live_count) {
+                peak_live_count = live_count;
+                statistics = allocator.statistics();
+            }
+        } else {
+            allocator.deallocate(slots[operation.m_slot], false);
+            --live_count;
+        }
+    }
+
+    return statistics;
+}
+
+BENCHMARK_CASE(small_object_workload)
+{
+    static std::array<u8, 128 * KiB> heap;
+
+    for (usize live_count : { 32, 128, 512 }) {
+        auto operations = generate_small_object_workload(20000, live_count);
+
+        usize slot_count = 0;
+        for (auto& operation : operations)
+            slot_count = std::max(slot_count, operation.m_slot + 1);
+
+        for (bool use_size_classes : { false, true }) {
+            Std::MemoryAllocator::Statistics statistics;
+
+            double ns = Benchmarks::measure([&] {
+                statistics = replay({ heap.data(), heap.size() }, operations, slot_count, use_size_classes);
+            }, std::chrono::milliseconds(200));
+
+            // Share of the free memory that is not part of the largest block
+            double fragmentation = 1.0 - double(statistics.m_largest_continous_block) / double(statistics.m_avaliable_memory);
+
+            printf("  %3zu live, %-12s %6.2f Mops/s  at peak: %6zu bytes free, %5.1f%% fragmented, %5zu bytes in free slots\n",
+                live_count,
+                use_size_classes ? "size classes" : "free list",
+                double(operations.size()) / ns * 1000.0,
+                statistics.m_avaliable_memory,
+                fragmentation * 100.0,
+                statistics.m_size_class_memory);
+        }
+    }
+}
+
+// Replays the operations and records how long each of them took in nanoseconds, reading the clock costs a few
+// nanoseconds which are included in every sample.
+template<typename Allocator>
+static std::vector<u64> replay_with_latencies(Allocator& allocator, const std::vector<Operation>& operations, usize slot_count)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<u8*> slots(slot_count);
+    std::vector<u64> latencies;
+    latencies.reserve(operations.size());
+
+    for (auto& operation : operations) {
+        auto start = Clock::now();
+
+        if (operation.m_size != 0)
+            slots[operation.m_slot] = allocator.allocate(operation.m_size, false);
+        else
+            allocator.deallocate(slots[operation.m_slot], false);
+
+        auto end = Clock::now();
+        latencies.push_back(u64(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    }
+
+    return latencies;
+}
+
+BENCHMARK_CASE(operation_latency)
+{
+    static std::array<u8, 256 * KiB> heap;
+
+    // Many live objects fragment the heap and make the search for a fitting block long
+    for (usize live_count : { 128, 1024 }) {
+        auto operations = generate_small_object_workload(50000, live_count);
+
+        usize slot_count = 0;
+        for (auto& operation : operations)
+            slot_count = std::max(slot_count, operation.m_slot + 1);
+
+        auto report = [&](const char *name, std::vector<u64> latencies) {
+            std::sort(latencies.begin(), latencies.end());
+
+            auto percentile = [&](double fraction) {
+                return latencies[usize(fraction * double(latencies.size() - 1))];
+            };
+
+            printf("  %4zu live, %-12s p50 %5llu ns  p99 %6llu ns  max %7llu ns\n",
+                live_count, name, (unsigned long long)percentile(0.5), (unsigned long long)percentile(0.99), (unsigned long long)latencies.back());
+        };
+
+        // Interrupts and page faults hit random operations, only the fastest of several runs is kept
+        auto fastest_of_runs = [&](auto create_allocator) {
+            std::vector<u64> latencies;
+
+            for (usize run = 0; run < 5; ++run) {
+                auto allocator = create_allocator();
+                auto run_latencies = replay_with_latencies(allocator, operations, slot_count);
+
+                if (run == 0)
+                    latencies = run_latencies;
+                for (usize index = 0; index < latencies.size(); ++index)
+                    latencies[index] = std::min(latencies[index], run_latencies[index]);
+            }
+
+            return latencies;
+        };
+
+        for (bool use_size_classes : { false, true }) {
+            report(use_size_classes ? "size classes" : "free list", fastest_of_runs([&] {
+                Std::MemoryAllocator allocator { { heap.data(), heap.size() } };
+                allocator.m_use_size_classes = use_size_classes;
+                return allocator;
+            }));
+        }
+
+        report("tlsf", fastest_of_runs([&] {
+            return Std::TlsfAllocator { { heap.data(), heap.size() } };
+        }));
+    }
+}
+
+// Mirrors how 'MemoryFile::append' grows its 'Vector<u8>': the capacity is doubled and the data is moved only if
+// the allocator can not grow the block in place.
+struct AppendOnlyFile {
+    Std::MemoryAllocator& m_allocator;
+    bool m_in_place;
+
+    u8 *m_data = nullptr;
+    usize m_size = 0;
+    usize m_capacity = 0;
+
+    usize m_copied_bytes = 0;
+
+    void append(const u8 *bytes, usize size)
+    {
+        if (m_size + size > m_capacity) {
+            usize new_capacity = std::max<usize>(16, m_capacity);
+            while (new_capacity < m_size + size)
+                new_capacity *= 2;
+
+            u8 *new_data;
+            if (m_in_place) {
+                new_data = m_allocator.reallocate(m_data, new_capacity, false);
+            } else {
+                new_data = m_allocator.allocate(new_capacity, false);
+                if (m_data != nullptr)
+                    memcpy(new_data, m_data, m_size);
+                m_allocator.deallocate(m_data, false);
+            }
+
+            if (new_data != m_data)
+                m_copied_bytes += m_size;
+
+            m_data = new_data;
+            m_capacity = new_capacity;
+        }
+
+        memcpy(m_data + m_size, bytes, size);
+        m_size += size;
+    }
+};
+
+BENCHMARK_CASE(memoryfile_append)
+{
+    static std::array<u8, 256 * KiB> heap;
+
+    std::array<u8, 64> chunk;
+    chunk.fill(0x42);
+
+    // A single file grows alone, two files that are written alternately get in the way of each other
+    for (usize file_count : { 1, 2 }) {
+        for (bool in_place : { false, true }) {
+            constexpr usize file_size = 48 * KiB;
+            usize copied_bytes = 0;
+
+            double ns = Benchmarks::measure([&] {
+                Std::MemoryAllocator allocator { { heap.data(), heap.size() } };
+
+                std::vector<AppendOnlyFile> files(file_count, AppendOnlyFile { allocator, in_place });
+                for (usize offset = 0; offset < file_size; offset += chunk.size()) {
+                    for (auto& file : files)
+                        file.append(chunk.data(), chunk.size());
+                }
+
+                copied_bytes = 0;
+                for (auto& file : files) {
+                    Benchmarks::do_not_optimize(file.m_data);
+
+                    copied_bytes += file.m_copied_bytes;
+                    allocator.deallocate(file.m_data, false);
+                }
+            });
+
+            printf("  %zu file(s), %-9s %8.2f MiB/s appended, %7zu bytes copied\n",
+                file_count,
+                in_place ? "in place" : "copying",
+                double(file_count * file_size) / ns * 1e9 / double(MiB),
+                copied_bytes);
+        }
+    }
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/Path.hpp>
+#include <Std/Lexer.hpp>
+
+#include <cstdio>
+
+// The previous implementation stored every component as a separate string; a reduced copy is kept here for
+// comparison.
+namespace Legacy
+{
+    class Path {
+    public:
+        Path(Std::StringView path)
+        {
+            Std::Lexer lexer { path };
+
+            m_is_absolute = lexer.try_consume('/');
+
+            while (!lexer.eof()) {
+                m_components.append(lexer.consume_until('/'));
+
+                if (!lexer.eof())
+                    lexer.try_consume('/');
+            }
+        }
+        Path(const char *path)
+            : Path(Std::StringView { path })
+        {
+        }
+
+        Path parent() const
+        {
+            Path parent { *this };
+            parent.m_components.erase(parent.m_components.size() - 1);
+            return parent;
+        }
+
+        Std::String filename() const { return m_components[m_components.size() - 1]; }
+
+        Path operator/(const Path& rhs) const
+        {
+            Path path = *this;
+            path.m_components.extend(rhs.m_components.span());
+            return path;
+        }
+
+    private:
+        bool m_is_absolute;
+        Std::Vector<Std::String> m_components;
+    };
+}
+
+// Resolves a relative path against the working directory and looks at the parent, like 'sys$open' with 'O_CREAT'.
+BENCHMARK_CASE(resolve_relative)
+{
+    const char *names[] = { "Shell.elf", "Editor.elf", "some-longer-file-name.txt", "Example.elf" };
+
+    Legacy::Path legacy_working_directory { "/home/user/projects" };
+    double legacy_ns = Benchmarks::measure([&] {
+        for (const char *name : names) {
+            Legacy::Path path = legacy_working_directory / name;
+            Benchmarks::do_not_optimize(path.parent());
+            Benchmarks::do_not_optimize(path.filename());
+        }
+    });
+
+    Std::Path working_directory { "/home/user/projects" };
+    double current_ns = Benchmarks::measure([&] {
+        for (const char *name : names) {
+            Std::Path path = working_directory / name;
+            Benchmarks::do_not_optimize(path.parent());
+            Benchmarks::do_not_optimize(path.filename());
+        }
+    });
+
+    printf("  per path: string per component %6.1f ns  single buffer %6.1f ns\n", legacy_ns / 4, current_ns / 4);
+}
+
+BENCHMARK_MAIN();
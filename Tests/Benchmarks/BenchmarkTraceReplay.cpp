@@ -0,0 +1,444 @@
+#include <Tests/BenchmarkSuite.hpp>
+
+#include <Std/MemoryAllocator.hpp>
+#include <Std/TlsfAllocator.hpp>
+
+#include <Kernel/Interface/HeapTrace.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using Kernel::HeapTrace::Event;
+using Kernel::HeapTrace::Kind;
+
+// The allocations of a trace, each object that is alive at the same time has its own slot.
+struct Operation {
+    enum class Type {
+        Allocate,
+        Deallocate,
+        Reallocate,
+    };
+
+    Type m_type;
+    usize m_slot;
+    usize m_size;
+};
+
+struct Trace {
+    std::string m_name;
+    std::vector<Operation> m_operations;
+    usize m_slot_count = 0;
+};
+
+// The pointers in the events only identify the objects, the replay places them in a heap of its own.
+static Trace trace_from_events(std::string name, const std::vector<Event>& events)
+{
+    Trace trace;
+    trace.m_name = std::move(name);
+    std::unordered_map<u32, usize> slots;
+
+    auto allocate = [&](u32 pointer, usize size) {
+        slots[pointer] = trace.m_slot_count;
+        trace.m_operations.push_back({ Operation::Type::Allocate, trace.m_slot_count++, size });
+    };
+
+    for (auto& event : events) {
+        switch (event.m_kind) {
+        case Kind::Start:
+            // Stands in for everything that was allocated before the trace started
+            if (event.m_size > 0)
+                trace.m_operations.push_back({ Operation::Type::Allocate, trace.m_slot_count++, event.m_size });
+            break;
+        case Kind::Allocate:
+            allocate(event.m_pointer, event.m_size);
+            break;
+        case Kind::Deallocate:
+            if (auto iterator = slots.find(event.m_pointer); iterator != slots.end()) {
+                trace.m_operations.push_back({ Operation::Type::Deallocate, iterator->second, 0 });
+                slots.erase(iterator);
+            }
+            break;
+        case Kind::Reallocate:
+            if (auto iterator = slots.find(event.m_pointer); iterator != slots.end()) {
+                usize slot = iterator->second;
+                slots.erase(iterator);
+
+                trace.m_operations.push_back({ Operation::Type::Reallocate, slot, event.m_size });
+                slots[event.m_new_pointer] = slot;
+            } else {
+                allocate(event.m_new_pointer, event.m_size);
+            }
+            break;
+        case Kind::AddRegion:
+        case Kind::RemoveRegion:
+            // The heap of the replay has a fixed size
+            break;
+        }
+    }
+
+    return trace;
+}
+
+// Extracts the events from a console capture of a kernel built with 'KERNEL_HEAP_TRACE', see 'Tools/HeapProfiler'.
+static std::vector<Event> events_from_capture(const std::vector<u8>& data)
+{
+    std::vector<Event> events;
+
+    for (usize offset = 0; offset + sizeof(Event) <= data.size();) {
+        Event event;
+        memcpy(&event, data.data() + offset, sizeof(event));
+
+        bool is_event = event.m_magic[0] == Kernel::HeapTrace::magic[0]
+            && event.m_magic[1] == Kernel::HeapTrace::magic[1]
+            && event.m_reserved == 0
+            && u8(event.m_kind) != 0 && u8(event.m_kind) <= Kernel::HeapTrace::last_kind;
+
+        if (is_event) {
+            events.push_back(event);
+            offset += sizeof(Event);
+        } else {
+            offset += 1;
+        }
+    }
+
+    return events;
+}
+
+// Produces events like the kernel would, the pointers are never reused.
+class TraceBuilder {
+public:
+    u32 allocate(usize size)
+    {
+        u32 pointer = m_next_pointer++;
+        m_events.push_back(event(Kind::Allocate, pointer, 0, size));
+        return pointer;
+    }
+
+    void deallocate(u32 pointer)
+    {
+        m_events.push_back(event(Kind::Deallocate, pointer, 0, 0));
+    }
+
+    u32 reallocate(u32 pointer, usize size)
+    {
+        u32 new_pointer = m_next_pointer++;
+        m_events.push_back(event(Kind::Reallocate, pointer, new_pointer, size));
+        return new_pointer;
+    }
+
+    // Grows like 'Vector' does, by doubling the capacity
+    u32 grow(u32 pointer, usize& capacity, usize needed)
+    {
+        if (needed <= capacity)
+            return pointer;
+
+        while (capacity < needed)
+            capacity = std::max<usize>(capacity * 2, 16);
+
+        return pointer == 0 ? allocate(capacity) : reallocate(pointer, capacity);
+    }
+
+    std::vector<Event> m_events;
+
+private:
+    static Event event(Kind kind, u32 pointer, u32 new_pointer, usize size)
+    {
+        Event event {};
+        event.m_magic[0] = Kernel::HeapTrace::magic[0];
+        event.m_magic[1] = Kernel::HeapTrace::magic[1];
+        event.m_kind = kind;
+        event.m_pointer = pointer;
+        event.m_new_pointer = new_pointer;
+        event.m_size = u32(size);
+        return event;
+    }
+
+    u32 m_next_pointer = 1;
+};
+
+// Mounting the file systems and interning their names, these objects live until the kernel shuts down.  Plenty
+// of short lived format buffers are created in between.
+static std::vector<Event> generate_boot_events()
+{
+    std::mt19937 prng { 11 };
+    TraceBuilder builder;
+
+    u32 buckets = 0;
+    usize bucket_capacity = 0;
+
+    for (usize index = 0; index < 120; ++index) {
+        builder.allocate(8 + prng() % 32);
+        builder.allocate(40);
+
+        buckets = builder.grow(buckets, bucket_capacity, (index + 1) * 8);
+
+        if (index % 2 == 0) {
+            u32 buffer = 0;
+            usize capacity = 0;
+            buffer = builder.grow(buffer, capacity, 20 + prng() % 60);
+            builder.deallocate(buffer);
+        }
+    }
+
+    // The kernel log and the queue of the scheduler
+    builder.allocate(4 * KiB);
+    builder.allocate(64);
+
+    return builder.m_events;
+}
+
+// Commands typed into the shell, a line is read and split into arguments before the command runs.  Only the
+// history outlives the command.
+static std::vector<Event> generate_shell_events()
+{
+    std::mt19937 prng { 12 };
+    TraceBuilder builder;
+
+    std::vector<u32> history;
+
+    for (usize command = 0; command < 400; ++command) {
+        u32 line = 0;
+        usize line_capacity = 0;
+        usize line_length = 4 + prng() % 60;
+        for (usize length = 8; length < line_length + 8; length += 8)
+            line = builder.grow(line, line_capacity, length);
+
+        u32 arguments = 0;
+        usize arguments_capacity = 0;
+        std::vector<u32> strings;
+        usize argument_count = 1 + prng() % 6;
+        for (usize argument = 0; argument < argument_count; ++argument) {
+            arguments = builder.grow(arguments, arguments_capacity, (argument + 1) * sizeof(u32));
+            strings.push_back(builder.allocate(2 + prng() % 20));
+        }
+
+        u32 output = builder.allocate(32 + prng() % 200);
+
+        history.push_back(builder.allocate(line_length));
+        if (history.size() > 50) {
+            builder.deallocate(history.front());
+            history.erase(history.begin());
+        }
+
+        builder.deallocate(output);
+        for (u32 string : strings)
+            builder.deallocate(string);
+        builder.deallocate(arguments);
+        builder.deallocate(line);
+    }
+
+    return builder.m_events;
+}
+
+// Spawning a process over and over, the kernel objects of each one are freed when it exits.  The exit status is
+// kept until the parent collects it, this interleaves the lifetimes.
+static std::vector<Event> generate_spawn_events()
+{
+    std::mt19937 prng { 13 };
+    TraceBuilder builder;
+
+    std::vector<u32> statuses;
+
+    for (usize spawn = 0; spawn < 300; ++spawn) {
+        std::vector<u32> objects;
+
+        objects.push_back(builder.allocate(180));
+        objects.push_back(builder.allocate(16 + prng() % 24));
+        objects.push_back(builder.allocate(200));
+        objects.push_back(builder.allocate(48));
+
+        u32 handles = 0;
+        usize handles_capacity = 0;
+        usize handle_count = 3 + prng() % 4;
+        for (usize handle = 0; handle < handle_count; ++handle) {
+            handles = builder.grow(handles, handles_capacity, (handle + 1) * 16);
+            objects.push_back(builder.allocate(16));
+        }
+        objects.push_back(handles);
+
+        // The arguments are copied into an arena until they are on the stack of the process
+        u32 arena = builder.allocate(1 * KiB);
+        builder.deallocate(arena);
+
+        statuses.push_back(builder.allocate(16));
+        if (statuses.size() > 8) {
+            builder.deallocate(statuses.front());
+            statuses.erase(statuses.begin());
+        }
+
+        std::shuffle(objects.begin(), objects.end(), prng);
+        for (u32 object : objects)
+            builder.deallocate(object);
+    }
+
+    return builder.m_events;
+}
+
+// Captures recorded on the device are listed in 'HEAP_TRACES', separated by colons.
+static std::vector<Trace> load_traces()
+{
+    std::vector<Trace> traces;
+    traces.push_back(trace_from_events("boot", generate_boot_events()));
+    traces.push_back(trace_from_events("shell", generate_shell_events()));
+    traces.push_back(trace_from_events("spawn", generate_spawn_events()));
+
+    const char *paths = getenv("HEAP_TRACES");
+    if (paths == nullptr)
+        return traces;
+
+    std::string remaining = paths;
+    while (!remaining.empty()) {
+        usize separator = std::min(remaining.find(':'), remaining.size());
+        std::string path = remaining.substr(0, separator);
+        remaining.erase(0, std::min(separator + 1, remaining.size()));
+
+        std::ifstream file { path, std::ios::binary };
+        if (!file) {
+            printf("  Can not open '%s'\n", path.c_str());
+            continue;
+        }
+
+        std::vector<u8> data { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        traces.push_back(trace_from_events(path, events_from_capture(data)));
+    }
+
+    return traces;
+}
+
+struct ReplayResult {
+    // Heap in use including the overhead of the allocator
+    usize m_peak_footprint = 0;
+    usize m_largest_free_block_at_peak = 0;
+    usize m_largest_free_block_at_end = 0;
+
+    usize m_failure_count = 0;
+    usize m_first_failure = 0;
+    usize m_first_failure_size = 0;
+};
+
+// Allocations that fail are skipped, the objects in these slots are never freed.  If 'result' is given, the heap
+// is inspected after every operation.
+template<typename Allocator>
+static void replay(Allocator& allocator, const Trace& trace, std::vector<u8*>& slots, ReplayResult *result)
+{
+    usize heap_size = allocator.heap_size();
+
+    for (usize index = 0; index < trace.m_operations.size(); ++index) {
+        auto& operation = trace.m_operations[index];
+        u8*& slot = slots[operation.m_slot];
+
+        bool failed = false;
+        switch (operation.m_type) {
+        case Operation::Type::Allocate:
+            slot = allocator.try_allocate(operation.m_size);
+            failed = slot == nullptr;
+            break;
+        case Operation::Type::Deallocate:
+            allocator.deallocate(slot, false);
+            slot = nullptr;
+            break;
+        case Operation::Type::Reallocate:
+            if (slot == nullptr || allocator.try_reallocate_in_place(slot, operation.m_size))
+                break;
+
+            if (u8 *new_slot = allocator.try_allocate(operation.m_size)) {
+                memcpy(new_slot, slot, std::min(operation.m_size, Allocator::usable_size(slot)));
+                allocator.deallocate(slot, false);
+                slot = new_slot;
+            } else {
+                failed = true;
+            }
+            break;
+        }
+
+        if (result == nullptr)
+            continue;
+
+        if (failed) {
+            if (result->m_failure_count++ == 0) {
+                result->m_first_failure = index;
+                result->m_first_failure_size = operation.m_size;
+            }
+            continue;
+        }
+
+        auto statistics = allocator.statistics();
+
+        usize footprint = heap_size - statistics.m_avaliable_memory - statistics.m_size_class_memory;
+        if (footprint > result->m_peak_footprint) {
+            result->m_peak_footprint = footprint;
+            result->m_largest_free_block_at_peak = statistics.m_largest_continous_block;
+        }
+        result->m_largest_free_block_at_end = statistics.m_largest_continous_block;
+    }
+}
+
+template<typename CreateAllocator>
+static void report(const char *name, Std::Bytes heap, const Trace& trace, CreateAllocator create_allocator)
+{
+    std::vector<u8*> slots(trace.m_slot_count);
+
+    // The heap is inspected separately, that would dominate the time
+    ReplayResult result;
+    {
+        auto allocator = create_allocator(heap);
+        replay(allocator, trace, slots, &result);
+    }
+
+    double ns = Benchmarks::measure([&] {
+        auto allocator = create_allocator(heap);
+        std::fill(slots.begin(), slots.end(), nullptr);
+        replay(allocator, trace, slots, nullptr);
+    }, std::chrono::milliseconds(100));
+
+    printf("    %-12s %6.1f ns/op  peak %6zu bytes  largest free %6zu at peak %6zu at end",
+        name,
+        ns / double(trace.m_operations.size()),
+        result.m_peak_footprint,
+        result.m_largest_free_block_at_peak,
+        result.m_largest_free_block_at_end);
+
+    if (result.m_failure_count > 0)
+        printf("  %zu failed, first at #%zu (%zu bytes)", result.m_failure_count, result.m_first_failure, result.m_first_failure_size);
+
+    printf("\n");
+}
+
+BENCHMARK_CASE(trace_replay)
+{
+    alignas(16) static std::array<u8, 64 * KiB> heap;
+
+    for (auto& trace : load_traces()) {
+        printf("  %s: %zu operations\n", trace.m_name.c_str(), trace.m_operations.size());
+
+        // The initial kernel heap and a heap that is large enough for everything
+        for (usize heap_size : { 16 * KiB, 64 * KiB }) {
+            printf("   %zu KiB heap\n", heap_size / KiB);
+
+            Std::Bytes bytes { heap.data(), heap_size };
+
+            report("free list", bytes, trace, [](Std::Bytes heap) {
+                Std::MemoryAllocator allocator { heap };
+                allocator.m_use_size_classes = false;
+                return allocator;
+            });
+            report("size classes", bytes, trace, [](Std::Bytes heap) {
+                return Std::MemoryAllocator { heap };
+            });
+            report("tlsf", bytes, trace, [](Std::Bytes heap) {
+                return Std::TlsfAllocator { heap };
+            });
+        }
+    }
+}
+
+BENCHMARK_MAIN();
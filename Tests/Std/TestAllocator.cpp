@@ -0,0 +1,163 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/Allocator.hpp>
+#include <Std/MemoryAllocator.hpp>
+#include <Std/Vector.hpp>
+#include <Std/String.hpp>
+#include <Std/SortedSet.hpp>
+#include <Std/HashTable.hpp>
+#include <Std/HashMap.hpp>
+#include <Std/CircularQueue.hpp>
+
+#include <array>
+
+using Pool = Std::PoolAllocator<Std::MemoryAllocator>;
+
+// Every container draws from its own pool, none of them may fall back to the global heap.
+struct PoolFixture {
+    PoolFixture()
+        : m_pool({ m_heap.data(), m_heap.size() })
+    {
+        m_available_before = m_pool.statistics().m_avaliable_memory;
+        m_allocations_before = Tests::allocation_count();
+    }
+
+    usize used() { return m_available_before - m_pool.statistics().m_avaliable_memory; }
+
+    void verify_no_global_allocations()
+    {
+        ASSERT(Tests::allocation_count() == m_allocations_before);
+    }
+
+    alignas(16) std::array<u8, 0x4000> m_heap;
+    Std::MemoryAllocator m_pool;
+
+    usize m_available_before;
+    size_t m_allocations_before;
+};
+
+TEST_CASE(allocator_vector)
+{
+    PoolFixture fixture;
+
+    {
+        Std::Vector<u32, 0, Pool> vector { fixture.m_pool };
+        for (u32 index = 0; index < 500; ++index)
+            vector.append(index);
+
+        ASSERT(fixture.used() >= 500 * sizeof(u32));
+
+        vector.shrink_to_fit();
+        for (u32 index = 0; index < 500; ++index)
+            ASSERT(vector[index] == index);
+    }
+
+    fixture.verify_no_global_allocations();
+    ASSERT(fixture.used() == 0);
+}
+
+TEST_CASE(allocator_string)
+{
+    PoolFixture fixture;
+
+    {
+        Std::BasicString<Pool> string { "a string that does not fit inline", fixture.m_pool };
+        ASSERT(fixture.used() > 0);
+
+        Std::BasicString<Pool> copy = string;
+        Std::BasicString<Pool> moved = move(string);
+
+        ASSERT(copy == "a string that does not fit inline");
+        ASSERT(moved == copy);
+        ASSERT(string.size() == 0);
+    }
+
+    fixture.verify_no_global_allocations();
+    ASSERT(fixture.used() == 0);
+}
+
+TEST_CASE(allocator_sortedset)
+{
+    PoolFixture fixture;
+
+    {
+        Std::SortedSet<u32, Pool> set { fixture.m_pool };
+        for (u32 index = 0; index < 100; ++index)
+            set.insert((index * 37) % 100);
+
+        for (u32 index = 0; index < 50; ++index)
+            set.remove(index * 2);
+
+        set.verify_invariants();
+        ASSERT(set.size() == 50);
+        ASSERT(fixture.used() > 0);
+    }
+
+    fixture.verify_no_global_allocations();
+    ASSERT(fixture.used() == 0);
+}
+
+TEST_CASE(allocator_hashtable)
+{
+    PoolFixture fixture;
+
+    {
+        Std::HashTable<u32, Pool> table { fixture.m_pool };
+        for (u32 index = 0; index < 200; ++index)
+            table.insert(index);
+
+        for (u32 index = 0; index < 200; ++index)
+            ASSERT(table.search(index) != nullptr);
+        ASSERT(fixture.used() > 0);
+
+        // The storage moves along with the allocator
+        Std::HashTable<u32, Pool> other { fixture.m_pool };
+        other = move(table);
+        ASSERT(other.size() == 200);
+    }
+
+    fixture.verify_no_global_allocations();
+    ASSERT(fixture.used() == 0);
+}
+
+TEST_CASE(allocator_hashmap)
+{
+    PoolFixture fixture;
+
+    {
+        Std::HashMap<u32, u32, Pool> map { fixture.m_pool };
+        for (u32 index = 0; index < 100; ++index)
+            map.set(index, index * 2);
+
+        ASSERT(*map.get(42) == 84);
+        ASSERT(fixture.used() > 0);
+    }
+
+    fixture.verify_no_global_allocations();
+    ASSERT(fixture.used() == 0);
+}
+
+TEST_CASE(allocator_circularqueue)
+{
+    PoolFixture fixture;
+
+    {
+        Std::GrowableCircularQueue<u32, Pool> queue { fixture.m_pool };
+        for (u32 index = 0; index < 100; ++index) {
+            queue.enqueue(index);
+            queue.enqueue_front(index);
+        }
+        ASSERT(fixture.used() >= 200 * sizeof(u32));
+
+        for (u32 index = 100; index-- > 0;)
+            ASSERT(queue.dequeue() == index);
+
+        queue.shrink_to_fit();
+        ASSERT(queue.size() == 100 && queue.front() == 0);
+    }
+
+    fixture.verify_no_global_allocations();
+    ASSERT(fixture.used() == 0);
+}
+
+TEST_MAIN();
@@ -0,0 +1,124 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/Arena.hpp>
+#include <Std/Vector.hpp>
+
+TEST_CASE(arena)
+{
+    Std::Arena arena;
+    ASSERT(arena.chunk_count() == 0);
+
+    u8 *pointer1 = arena.allocate(3, 1);
+    u8 *pointer2 = arena.allocate(8);
+    ASSERT(arena.chunk_count() == 1);
+
+    // Allocations are bumped, only the alignment is skipped
+    ASSERT(pointer2 == pointer1 + sizeof(usize));
+    ASSERT(uptr(pointer2) % sizeof(usize) == 0);
+
+    u64 *values = arena.allocate_array<u64>(4);
+    ASSERT(uptr(values) % alignof(u64) == 0);
+    for (usize index = 0; index < 4; ++index)
+        values[index] = index;
+
+    arena.clear();
+    ASSERT(arena.chunk_count() == 0);
+}
+
+TEST_CASE(arena_chunks)
+{
+    Std::Arena arena;
+
+    // Filling the first chunk starts a second one
+    for (usize index = 0; index < 200; ++index)
+        arena.allocate(16);
+    ASSERT(arena.chunk_count() > 1);
+
+    // Large allocations get a chunk of their own
+    usize chunk_count = arena.chunk_count();
+    u8 *pointer = arena.allocate(5000);
+    for (usize index = 0; index < 5000; ++index)
+        pointer[index] = u8(index);
+    ASSERT(arena.chunk_count() == chunk_count + 1);
+
+    // The chunks move with the arena
+    Std::Arena other { move(arena) };
+    ASSERT(arena.chunk_count() == 0);
+    ASSERT(other.chunk_count() == chunk_count + 1);
+    for (usize index = 0; index < 5000; ++index)
+        ASSERT(pointer[index] == u8(index));
+}
+
+TEST_CASE(arena_last_allocation)
+{
+    Std::Arena arena;
+
+    u8 *pointer1 = arena.allocate(16);
+    u8 *pointer2 = arena.allocate(16);
+
+    // Only the most recent allocation can grow
+    ASSERT(!arena.try_reallocate_in_place(pointer1, 16, 32));
+    ASSERT(arena.try_reallocate_in_place(pointer2, 16, 32));
+
+    // Freeing the most recent allocation gives its memory back
+    arena.deallocate(pointer2, 32);
+    ASSERT(arena.allocate(8) == pointer2);
+
+    // Other blocks stay until the arena is cleared
+    arena.deallocate(pointer1, 16);
+    ASSERT(arena.allocate(8) == pointer2 + sizeof(usize));
+}
+
+TEST_CASE(arena_copy)
+{
+    Std::Arena arena;
+
+    char buffer[] = "hello";
+    Std::StringView copy = arena.copy(Std::StringView { buffer });
+
+    buffer[0] = 'j';
+    ASSERT(copy == "hello");
+    ASSERT(copy.data()[copy.size()] == 0);
+
+    ASSERT(arena.copy("").size() == 0);
+}
+
+TEST_CASE(arena_vector)
+{
+    Std::Arena arena;
+
+    size_t allocations_before = Tests::allocation_count();
+
+    // The buffer of the last vector grows in place
+    Std::Vector<u32, 0, Std::ArenaAllocator> vector { arena };
+    for (u32 index = 0; index < 100; ++index)
+        vector.append(index);
+
+    Std::Vector<Std::StringView, 0, Std::ArenaAllocator> strings { arena };
+    strings.append(arena.copy("foo"));
+    strings.append(arena.copy("bar"));
+
+    ASSERT(arena.chunk_count() == 1);
+
+    for (u32 index = 0; index < 100; ++index)
+        ASSERT(vector[index] == index);
+    ASSERT(strings[0] == "foo" && strings[1] == "bar");
+
+    // The chunk was the only allocation from the heap
+    ASSERT(Tests::allocation_count() - allocations_before == 1);
+
+    // Moving between vectors of the same arena takes over the buffer
+    u32 *data = vector.data();
+    Std::Vector<u32, 0, Std::ArenaAllocator> moved { move(vector) };
+    ASSERT(moved.data() == data);
+    ASSERT(vector.size() == 0);
+
+    // Vectors of different arenas copy the elements instead
+    Std::Arena other_arena;
+    Std::Vector<u32, 0, Std::ArenaAllocator> other { other_arena };
+    other = move(moved);
+    ASSERT(other.data() != data);
+    ASSERT(other.size() == 100 && other[99] == 99);
+}
+
+TEST_MAIN();
@@ -0,0 +1,82 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/Atom.hpp>
+#include <Std/HashMap.hpp>
+
+TEST_CASE(atom_interned)
+{
+    Std::Atom atom1 = "bin";
+    Std::Atom atom2 { Std::String { "bin" } };
+    Std::Atom atom3 = "dev";
+
+    ASSERT(atom1 == atom2);
+    ASSERT(atom1 != atom3);
+    ASSERT(atom1.view().data() == atom2.view().data());
+
+    ASSERT(atom1 == Std::StringView { "bin" });
+    ASSERT(atom1.view().size() == 3);
+    ASSERT(atom1.hash() == Std::Hash<Std::StringView>::compute("bin"));
+}
+
+TEST_CASE(atom_lookup_does_not_create)
+{
+    auto before = Std::Atom::statistics();
+
+    ASSERT(!Std::Atom::lookup("does-not-exist").is_valid());
+    ASSERT(Std::Atom::statistics().m_atom_count == before.m_atom_count);
+
+    Std::Atom atom = "does-exist";
+    auto atom_opt = Std::Atom::lookup("does-exist");
+
+    ASSERT(atom_opt.is_valid());
+    ASSERT(atom_opt.value() == atom);
+    ASSERT(Std::Atom::statistics().m_atom_count == before.m_atom_count + 1);
+}
+
+TEST_CASE(atom_released)
+{
+    auto before = Std::Atom::statistics();
+
+    {
+        Std::Atom atom1 = "tmp";
+        Std::Atom atom2 = atom1;
+        Std::Atom atom3 = move(atom2);
+
+        ASSERT(atom2.is_null());
+
+        auto stats = Std::Atom::statistics();
+        ASSERT(stats.m_atom_count == before.m_atom_count + 1);
+        ASSERT(stats.m_reference_count == before.m_reference_count + 2);
+        ASSERT(stats.m_duplicate_bytes == before.m_duplicate_bytes + 4);
+
+        atom1 = "usr";
+        ASSERT(Std::Atom::statistics().m_atom_count == before.m_atom_count + 2);
+
+        atom3 = atom1;
+        ASSERT(Std::Atom::statistics().m_atom_count == before.m_atom_count + 1);
+    }
+
+    ASSERT(Std::Atom::statistics().m_atom_count == before.m_atom_count);
+    ASSERT(!Std::Atom::lookup("tmp").is_valid());
+    ASSERT(!Std::Atom::lookup("usr").is_valid());
+}
+
+TEST_CASE(atom_hashmap_key)
+{
+    Std::HashMap<Std::Atom, int> map;
+
+    map.set(".", 1);
+    map.set("..", 2);
+    map.set("bin", 3);
+
+    ASSERT(map.size() == 3);
+    ASSERT(map.get(Std::Atom { ".." }) != nullptr && *map.get(Std::Atom { ".." }) == 2);
+    ASSERT(map.get(Std::StringView { "bin" }) != nullptr && *map.get(Std::StringView { "bin" }) == 3);
+    ASSERT(map.get(Std::Atom { "dev" }) == nullptr);
+
+    map.remove(Std::Atom { "." });
+    ASSERT(map.size() == 2);
+    ASSERT(!Std::Atom::lookup(".").is_valid());
+}
+
+TEST_MAIN();
@@ -0,0 +1,117 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/BinaryLog.hpp>
+
+#include <cstring>
+#include <vector>
+
+using Kernel::BinaryLog::RecordHeader;
+using Kernel::BinaryLog::Tag;
+
+static std::vector<u8> last_record;
+
+void Std::dbgln_binary_raw(ReadonlyBytes record)
+{
+    last_record.assign(record.data(), record.data() + record.size());
+}
+
+static RecordHeader header_of(const std::vector<u8>& record)
+{
+    ASSERT(record.size() >= sizeof(RecordHeader));
+
+    RecordHeader header;
+    memcpy(&header, record.data(), sizeof(header));
+
+    ASSERT(header.m_magic[0] == Kernel::BinaryLog::magic[0]);
+    ASSERT(header.m_magic[1] == Kernel::BinaryLog::magic[1]);
+    ASSERT(header.m_size == record.size() - sizeof(RecordHeader));
+
+    return header;
+}
+
+static std::vector<u8> arguments_of(const std::vector<u8>& record)
+{
+    return { record.begin() + sizeof(RecordHeader), record.end() };
+}
+
+TEST_CASE(binarylog_encoder)
+{
+    const char *string = "{} {} {} {} {} {}";
+
+    Std::BinaryLogEncoder encoder { string };
+    encoder.encode(u32(0x01020304));
+    encoder.encode(i16(-2));
+    encoder.encode('x');
+    encoder.encode(true);
+    encoder.encode("abc");
+    encoder.encode(u8(7));
+
+    auto bytes = encoder.finalize();
+    std::vector<u8> record { bytes.data(), bytes.data() + bytes.size() };
+
+    auto header = header_of(record);
+    ASSERT(header.m_string_address == u32(uptr(string)));
+
+    std::vector<u8> expected {
+        u8(Tag::Unsigned) | 4, 0x04, 0x03, 0x02, 0x01,
+        u8(Tag::Signed) | 2, 0xfe, 0xff,
+        u8(Tag::Char) | 1, 'x',
+        u8(Tag::Bool) | 1, 1,
+        u8(Tag::String), 3, 0, 'a', 'b', 'c',
+        u8(Tag::Unsigned) | 1, 7,
+    };
+    ASSERT(arguments_of(record) == expected);
+}
+
+TEST_CASE(binarylog_pointer)
+{
+    int value = 0;
+    int *pointer = &value;
+
+    Std::BinaryLogEncoder encoder { "{}" };
+    encoder.encode(pointer);
+
+    auto bytes = encoder.finalize();
+    std::vector<u8> record { bytes.data(), bytes.data() + bytes.size() };
+    header_of(record);
+
+    auto arguments = arguments_of(record);
+    ASSERT(arguments.size() == 1 + sizeof(pointer));
+    ASSERT(arguments[0] == (u8(Tag::Pointer) | sizeof(pointer)));
+    ASSERT(std::memcmp(arguments.data() + 1, &pointer, sizeof(pointer)) == 0);
+}
+
+TEST_CASE(binarylog_formatted_on_device)
+{
+    // There is no binary representation for these, the formatter is used instead
+    Std::BinaryLogEncoder encoder { "{} {}" };
+    encoder.encode(Std::Optional<u8> {});
+    encoder.encode(Std::String { "foo" });
+
+    auto bytes = encoder.finalize();
+    std::vector<u8> record { bytes.data(), bytes.data() + bytes.size() };
+    header_of(record);
+
+    std::vector<u8> expected {
+        u8(Tag::String), 3, 0, 'n', 'i', 'l',
+        u8(Tag::String), 3, 0, 'f', 'o', 'o',
+    };
+    ASSERT(arguments_of(record) == expected);
+}
+
+TEST_CASE(binarylog_dbgln)
+{
+    dbgln("no arguments");
+
+    auto first_header = header_of(last_record);
+    ASSERT(arguments_of(last_record).empty());
+
+    dbgln("value={:d}", i32(-5));
+
+    // Only the address of the format string is in the record
+    auto second_header = header_of(last_record);
+    ASSERT(first_header.m_string_address != second_header.m_string_address);
+    ASSERT((arguments_of(last_record) == std::vector<u8> { u8(Tag::Signed) | 4, 0xfb, 0xff, 0xff, 0xff }));
+}
+
+TEST_MAIN();
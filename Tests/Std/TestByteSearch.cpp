@@ -0,0 +1,142 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/ByteSearch.hpp>
+#include <Std/StringView.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+
+static std::optional<usize> to_std(Std::Optional<usize> value)
+{
+    if (!value.is_valid())
+        return std::nullopt;
+    return value.value();
+}
+
+static std::optional<usize> to_std(size_t value)
+{
+    if (value == std::string_view::npos)
+        return std::nullopt;
+    return value;
+}
+
+static int sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+TEST_CASE(bytesearch_find_byte)
+{
+    const char *data = "hello, world";
+
+    ASSERT(Std::find_byte(data, 12, 'h').must() == 0);
+    ASSERT(Std::find_byte(data, 12, 'o').must() == 4);
+    ASSERT(Std::find_byte(data, 12, 'd').must() == 11);
+    ASSERT(!Std::find_byte(data, 12, 'x').is_valid());
+    ASSERT(!Std::find_byte(data, 0, 'h').is_valid());
+
+    // Only the given range is searched
+    ASSERT(!Std::find_byte(data, 4, 'o').is_valid());
+
+    // Bytes with the high bit set must not be confused with a match in the neighbouring byte
+    const char high[] = "\x80\x81\xff\x00\x01\x7f\x80\xfe\xff";
+    ASSERT(Std::find_byte(high, 9, '\x00').must() == 3);
+    ASSERT(Std::find_byte(high, 9, '\x7f').must() == 5);
+    ASSERT(Std::find_byte(high, 9, '\xfe').must() == 7);
+    ASSERT(Std::find_byte(high, 9, '\xff').must() == 2);
+}
+
+TEST_CASE(bytesearch_find_any_of)
+{
+    const char *data = "/usr/bin:/bin;/sbin";
+
+    ASSERT(Std::find_any_of(data, 19, ":;", 2).must() == 8);
+    ASSERT(Std::find_any_of(data, 19, ";", 1).must() == 13);
+    ASSERT(!Std::find_any_of(data, 19, "", 0).is_valid());
+    ASSERT(!Std::find_any_of(data, 19, "xyz", 3).is_valid());
+
+    // Uses the table instead of comparing words
+    ASSERT(Std::find_any_of(data, 19, "abcdefgh", 8).must() == 5);
+}
+
+TEST_CASE(bytesearch_find_bytes)
+{
+    const char *data = "abababcabc";
+
+    ASSERT(Std::find_bytes(data, 10, "abc", 3).must() == 4);
+    ASSERT(Std::find_bytes(data, 10, "", 0).must() == 0);
+    ASSERT(Std::find_bytes(data, 10, "cabc", 4).must() == 6);
+    ASSERT(!Std::find_bytes(data, 10, "abcd", 4).is_valid());
+    ASSERT(!Std::find_bytes(data, 2, "abc", 3).is_valid());
+}
+
+TEST_CASE(bytesearch_compare_bytes)
+{
+    ASSERT(Std::compare_bytes("abc", "abc", 3) == 0);
+    ASSERT(Std::compare_bytes("abc", "abd", 3) < 0);
+    ASSERT(Std::compare_bytes("abd", "abc", 3) > 0);
+    ASSERT(Std::compare_bytes("abc", "xyz", 0) == 0);
+
+    // Unsigned like 'memcmp'
+    ASSERT(Std::compare_bytes("\x80", "\x7f", 1) > 0);
+}
+
+TEST_CASE(bytesearch_random)
+{
+    std::mt19937 generator { 42 };
+
+    // Small alphabet to get plenty of matches, the buffer is offset to test all alignments
+    auto random_string = [&](size_t size) {
+        std::string value;
+        for (size_t index = 0; index < size; ++index)
+            value.push_back("abc\x80\xff"[generator() % 5]);
+        return value;
+    };
+
+    for (size_t round = 0; round < 5000; ++round) {
+        size_t alignment = generator() % 8;
+        std::string buffer = std::string(alignment, '-') + random_string(generator() % 70);
+
+        std::string_view haystack { buffer.data() + alignment, buffer.size() - alignment };
+        char needle = "abcd\x80\xff"[generator() % 6];
+
+        ASSERT(to_std(Std::find_byte(haystack.data(), haystack.size(), needle)) == to_std(haystack.find(needle)));
+
+        std::string needles = random_string(1 + generator() % 6);
+        ASSERT(to_std(Std::find_any_of(haystack.data(), haystack.size(), needles.data(), needles.size()))
+            == to_std(haystack.find_first_of(needles)));
+
+        std::string substring = random_string(generator() % 4);
+        ASSERT(to_std(Std::find_bytes(haystack.data(), haystack.size(), substring.data(), substring.size()))
+            == to_std(haystack.find(substring)));
+
+        // Equal prefixes with a difference at a random position, both sides with independent alignment
+        std::string other = std::string(generator() % 8, '-');
+        size_t other_alignment = other.size();
+        other += haystack;
+        if (haystack.size() > 0 && generator() % 2)
+            other[other_alignment + generator() % haystack.size()] ^= char(1 + generator() % 255);
+
+        const char *lhs = haystack.data();
+        const char *rhs = other.data() + other_alignment;
+        ASSERT(sign(Std::compare_bytes(lhs, rhs, haystack.size())) == sign(memcmp(lhs, rhs, haystack.size())));
+    }
+}
+
+TEST_CASE(bytesearch_stringview)
+{
+    // The view is not null terminated, the search must not run past its end
+    const char data[] = { 'a', 'b', 'c', 'x' };
+    Std::StringView view { data, 3 };
+
+    ASSERT(!view.index_of('x').is_valid());
+    ASSERT(view.index_of('c').must() == 2);
+    ASSERT(view.index_of("bc").must() == 1);
+    ASSERT(view.index_of_any("cb").must() == 1);
+}
+
+TEST_MAIN();
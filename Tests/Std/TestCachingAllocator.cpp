@@ -0,0 +1,268 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/CachingAllocator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Stands in for masking interrupts in the kernel
+struct SpinGuard {
+    SpinGuard()
+    {
+        while (m_lock.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+    ~SpinGuard()
+    {
+        m_lock.clear(std::memory_order_release);
+    }
+
+    static inline std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+};
+
+TEST_CASE(cachingallocator)
+{
+    alignas(16) std::array<u8, 0x2000> heap;
+
+    Std::CachingAllocator<Std::MemoryAllocator, SpinGuard> allocator { { heap.data(), heap.size() } };
+    Std::AllocationCache cache;
+
+    auto before = allocator.statistics();
+
+    // The first allocation fetches a whole batch
+    u8 *pointer1 = allocator.allocate(&cache, 12);
+    ASSERT(cache.cached_block_count() == Std::AllocationCache::batch_size - 1);
+
+    // Freed blocks go into the cache and are handed out again
+    allocator.deallocate(&cache, pointer1);
+    ASSERT(cache.cached_block_count() == Std::AllocationCache::batch_size);
+    ASSERT(allocator.allocate(&cache, 16) == pointer1);
+
+    // Large blocks are never cached
+    u8 *pointer2 = allocator.allocate(&cache, 500);
+    allocator.deallocate(&cache, pointer2);
+    ASSERT(cache.cached_block_count() == Std::AllocationCache::batch_size - 1);
+
+    allocator.deallocate(&cache, pointer1);
+    allocator.flush(cache);
+    ASSERT(cache.cached_block_count() == 0);
+
+    auto after = allocator.statistics();
+    ASSERT(after.m_avaliable_memory == before.m_avaliable_memory);
+}
+
+TEST_CASE(cachingallocator_magazine_full)
+{
+    alignas(16) std::array<u8, 0x2000> heap;
+
+    Std::CachingAllocator<Std::MemoryAllocator, SpinGuard> allocator { { heap.data(), heap.size() } };
+    Std::AllocationCache cache;
+
+    // Without a cache, the blocks come straight from the heap
+    std::vector<u8*> pointers;
+    for (usize index = 0; index < 3 * Std::AllocationCache::magazine_capacity; ++index)
+        pointers.push_back(allocator.allocate(nullptr, 32));
+
+    // A full magazine gives half of its blocks back
+    for (u8 *pointer : pointers) {
+        allocator.deallocate(&cache, pointer);
+        ASSERT(cache.m_magazines[2].m_count <= Std::AllocationCache::magazine_capacity);
+    }
+    ASSERT(cache.m_magazines[2].m_count > Std::AllocationCache::batch_size);
+
+    allocator.flush(cache);
+    allocator.heap_check();
+}
+
+TEST_CASE(cachingallocator_exhausted)
+{
+    alignas(16) std::array<u8, 0x800> heap;
+
+    Std::CachingAllocator<Std::MemoryAllocator, SpinGuard> allocator { { heap.data(), heap.size() } };
+    Std::AllocationCache cache;
+
+    // The heap is exhausted, except for the blocks in the cache
+    std::vector<u8*> pointers;
+    for (usize index = 0; index < Std::AllocationCache::magazine_capacity; ++index)
+        pointers.push_back(allocator.allocate(&cache, 64));
+    u8 *filler = allocator.allocate(allocator.statistics().m_largest_continous_block);
+
+    for (u8 *pointer : pointers)
+        allocator.deallocate(&cache, pointer);
+    ASSERT(cache.cached_block_count() == Std::AllocationCache::magazine_capacity);
+    ASSERT(allocator.statistics().m_largest_continous_block < 256);
+
+    // If the heap is exhausted, the cache is flushed before giving up
+    u8 *pointer = allocator.allocate(&cache, 256);
+    ASSERT(cache.cached_block_count() == 0);
+
+    allocator.deallocate(&cache, pointer);
+    allocator.deallocate(filler);
+    allocator.heap_check();
+}
+
+// Stands in for the page allocator in the kernel
+struct RegionSource {
+    static Std::Bytes grow(usize size)
+    {
+        usize region_size = std::max<usize>((size + 15) & ~usize(15), 0x1000);
+
+        ++m_grow_count;
+        return { reinterpret_cast<u8*>(std::aligned_alloc(16, region_size)), region_size };
+    }
+
+    static void release(Std::Bytes region)
+    {
+        ++m_release_count;
+        std::free(region.data());
+    }
+
+    static inline usize m_grow_count = 0;
+    static inline usize m_release_count = 0;
+};
+
+TEST_CASE(cachingallocator_grow)
+{
+    alignas(16) std::array<u8, 0x400> heap;
+
+    Std::CachingAllocator<Std::TlsfAllocator, SpinGuard> allocator { { heap.data(), heap.size() } };
+    allocator.m_grow_callback = RegionSource::grow;
+    allocator.m_release_callback = RegionSource::release;
+
+    Std::AllocationCache cache;
+
+    // The heap grows as needed
+    std::vector<u8*> pointers;
+    for (usize index = 0; index < 100; ++index) {
+        u8 *pointer = allocator.allocate(&cache, index % 2 == 0 ? 48 : 200);
+        std::memset(pointer, 0xff, index % 2 == 0 ? 48 : 200);
+
+        pointers.push_back(pointer);
+    }
+    ASSERT(RegionSource::m_grow_count > 1);
+    ASSERT(allocator.heap_size() > 100 * 48 + 100 * 200 / 2);
+
+    // Larger than any region so far
+    u8 *large_pointer = allocator.allocate(0x3000);
+    allocator.heap_check();
+
+    // Once they are entirely free, the regions are released again
+    allocator.deallocate(&cache, large_pointer);
+    for (u8 *pointer : pointers)
+        allocator.deallocate(&cache, pointer);
+    allocator.flush(cache);
+
+    ASSERT(RegionSource::m_release_count == RegionSource::m_grow_count);
+    ASSERT(allocator.heap_size() == heap.size());
+    allocator.heap_check();
+}
+
+template<typename Backend>
+static void stress_test()
+{
+    constexpr usize thread_count = 4;
+
+    alignas(16) static std::array<u8, 0x40000> heap;
+
+    Std::CachingAllocator<Backend, SpinGuard> allocator { { heap.data(), heap.size() } };
+    auto before = allocator.statistics();
+
+    // Some blocks are freed by another thread than the one that allocated them
+    std::mutex inbox_mutex;
+    std::vector<std::pair<u8*, usize>> inboxes[thread_count];
+
+    auto worker = [&](usize thread_index) {
+        Std::AllocationCache cache;
+
+        std::mt19937 prng { u32(1337 + thread_index) };
+        std::vector<std::pair<u8*, usize>> allocations;
+
+        auto deallocate = [&](u8 *pointer, usize size) {
+            for (usize offset = 0; offset < size; ++offset)
+                ASSERT(pointer[offset] == u8(size));
+
+            allocator.deallocate(&cache, pointer);
+        };
+
+        for (usize round = 0; round < 20000; ++round) {
+            usize action = prng() % 8;
+
+            if (allocations.empty() || (action < 4 && allocations.size() < 64)) {
+                // Mostly small blocks, these are cached
+                usize size = prng() % 4 == 0 ? 1 + prng() % 300 : 1 + prng() % 64;
+
+                u8 *pointer = allocator.allocate(&cache, size);
+                std::memset(pointer, u8(size), size);
+
+                allocations.emplace_back(pointer, size);
+            } else if (action < 7) {
+                usize index = prng() % allocations.size();
+                auto [pointer, size] = allocations[index];
+                allocations.erase(allocations.begin() + index);
+
+                deallocate(pointer, size);
+            } else {
+                auto [pointer, size] = allocations.back();
+                allocations.pop_back();
+
+                // The other thread may already be done
+                std::unique_lock lock { inbox_mutex };
+                auto& inbox = inboxes[(thread_index + 1) % thread_count];
+                if (inbox.size() < 64) {
+                    inbox.emplace_back(pointer, size);
+                } else {
+                    lock.unlock();
+                    deallocate(pointer, size);
+                }
+            }
+
+            if (round % 64 == 0) {
+                std::vector<std::pair<u8*, usize>> received;
+                {
+                    std::lock_guard lock { inbox_mutex };
+                    received.swap(inboxes[thread_index]);
+                }
+
+                for (auto [pointer, size] : received)
+                    deallocate(pointer, size);
+            }
+        }
+
+        for (auto [pointer, size] : allocations)
+            deallocate(pointer, size);
+
+        allocator.flush(cache);
+    };
+
+    std::vector<std::thread> threads;
+    for (usize thread_index = 0; thread_index < thread_count; ++thread_index)
+        threads.emplace_back(worker, thread_index);
+    for (auto& thread : threads)
+        thread.join();
+
+    for (auto& inbox : inboxes) {
+        for (auto [pointer, size] : inbox)
+            allocator.deallocate(pointer);
+    }
+    allocator.heap_check();
+
+    // Nothing was lost or handed out twice
+    auto after = allocator.statistics();
+    ASSERT(after.m_avaliable_memory == before.m_avaliable_memory);
+    ASSERT(after.m_largest_continous_block == before.m_largest_continous_block);
+}
+
+TEST_CASE(cachingallocator_threads)
+{
+    stress_test<Std::MemoryAllocator>();
+    stress_test<Std::TlsfAllocator>();
+}
+
+TEST_MAIN();
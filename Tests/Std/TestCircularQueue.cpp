@@ -1,6 +1,10 @@
 #include <Tests/TestSuite.hpp>
 
 #include <Std/CircularQueue.hpp>
+#include <Std/String.hpp>
+
+#include <deque>
+#include <random>
 
 TEST_CASE(circularqueue)
 {
@@ -179,4 +183,253 @@ TEST_CASE(circularqueue_extensive_use)
     ASSERT(queue.size() == 0);
 }
 
+TEST_CASE(growablecircularqueue)
+{
+    Std::GrowableCircularQueue<int> queue;
+
+    ASSERT(queue.capacity() == 0);
+
+    queue.enqueue(1);
+    queue.enqueue(2);
+    queue.enqueue(3);
+
+    ASSERT(queue.size() == 3);
+    ASSERT(queue.capacity() == 4);
+
+    ASSERT(queue.dequeue() == 1);
+    ASSERT(queue.dequeue() == 2);
+    ASSERT(queue.dequeue() == 3);
+
+    ASSERT(queue.size() == 0);
+}
+
+TEST_CASE(growablecircularqueue_grow_while_wrapped)
+{
+    Std::GrowableCircularQueue<int> queue;
+
+    for (int value = 0; value < 4; ++value)
+        queue.enqueue(value);
+
+    ASSERT(queue.dequeue() == 0);
+    ASSERT(queue.dequeue() == 1);
+
+    queue.enqueue(4);
+    queue.enqueue(5);
+
+    // The queue is full and wraps around the end of the buffer
+    ASSERT(queue.capacity() == 4);
+
+    for (int value = 6; value < 20; ++value)
+        queue.enqueue(value);
+
+    ASSERT(queue.capacity() == 32);
+    ASSERT(queue.size() == 18);
+
+    for (int value = 2; value < 20; ++value) {
+        ASSERT(queue[0] == value);
+        ASSERT(queue.dequeue() == value);
+    }
+}
+
+TEST_CASE(growablecircularqueue_both_ends)
+{
+    Std::GrowableCircularQueue<int> queue;
+
+    queue.enqueue_front(1);
+    queue.enqueue(2);
+    queue.enqueue_front(3);
+    queue.enqueue_front(4);
+    queue.enqueue(5);
+
+    ASSERT(queue.size() == 5);
+    ASSERT(queue.front() == 4);
+    ASSERT(queue.back() == 5);
+    ASSERT(queue[1] == 3);
+    ASSERT(queue[2] == 1);
+
+    ASSERT(queue.dequeue_back() == 5);
+    ASSERT(queue.dequeue() == 4);
+    ASSERT(queue.dequeue_back() == 2);
+    ASSERT(queue.dequeue() == 3);
+    ASSERT(queue.dequeue() == 1);
+    ASSERT(queue.size() == 0);
+}
+
+TEST_CASE(growablecircularqueue_enqueue_own_element)
+{
+    Std::GrowableCircularQueue<Std::String> queue;
+
+    queue.enqueue("this string is not stored inline");
+    queue.enqueue("second");
+    queue.enqueue("third");
+    queue.enqueue("fourth");
+
+    // Growing relocates the element that is being copied
+    queue.enqueue(queue.front());
+    queue.enqueue_front(queue.back());
+
+    ASSERT(queue.size() == 6);
+    ASSERT(queue.front() == "this string is not stored inline");
+    ASSERT(queue.back() == "this string is not stored inline");
+    ASSERT(queue[1] == "this string is not stored inline");
+    ASSERT(queue[4] == "fourth");
+}
+
+TEST_CASE(growablecircularqueue_destroy)
+{
+    Tests::Tracker::clear();
+
+    {
+        Std::GrowableCircularQueue<Tests::Tracker> queue;
+
+        queue.enqueue({});
+
+        Tests::Tracker::assert(1, 1, 0, 1);
+
+        queue.enqueue({});
+
+        Tests::Tracker::assert(2, 2, 0, 2);
+
+        queue.dequeue();
+
+        Tests::Tracker::assert(2, 3, 0, 4);
+
+        for (usize i = 0; i < 3; ++i)
+            queue.enqueue({});
+
+        Tests::Tracker::assert(5, 6, 0, 7);
+
+        // Growing relocates the four elements
+        queue.enqueue({});
+
+        Tests::Tracker::assert(6, 11, 0, 12);
+    }
+
+    Tests::Tracker::assert(6, 11, 0, 17);
+}
+
+TEST_CASE(growablecircularqueue_move)
+{
+    Tests::Tracker::clear();
+
+    {
+        Std::GrowableCircularQueue<Tests::Tracker> queue1;
+
+        queue1.enqueue({});
+        queue1.enqueue_front({});
+
+        Tests::Tracker::assert(2, 2, 0, 2);
+
+        {
+            Std::GrowableCircularQueue<Tests::Tracker> queue2 = move(queue1);
+
+            // The storage is handed over, the elements themselves are not touched
+            Tests::Tracker::assert(2, 2, 0, 2);
+
+            ASSERT(queue1.size() == 0);
+            ASSERT(queue1.capacity() == 0);
+            ASSERT(queue2.size() == 2);
+        }
+
+        Tests::Tracker::assert(2, 2, 0, 4);
+    }
+
+    Tests::Tracker::assert(2, 2, 0, 4);
+}
+
+TEST_CASE(growablecircularqueue_shrink_to_fit)
+{
+    Std::GrowableCircularQueue<int> queue;
+
+    for (int value = 0; value < 100; ++value)
+        queue.enqueue(value);
+
+    ASSERT(queue.capacity() == 128);
+
+    for (int value = 0; value < 95; ++value)
+        ASSERT(queue.dequeue() == value);
+
+    queue.enqueue(100);
+    queue.enqueue(101);
+    queue.enqueue(102);
+
+    // The elements wrap around the end of the buffer
+    queue.shrink_to_fit();
+
+    ASSERT(queue.capacity() == 8);
+    ASSERT(queue.size() == 8);
+
+    for (int value = 95; value < 103; ++value)
+        ASSERT(queue.dequeue() == value);
+
+    queue.shrink_to_fit();
+
+    ASSERT(queue.capacity() == 0);
+
+    queue.enqueue(1);
+    ASSERT(queue.dequeue() == 1);
+}
+
+TEST_CASE(growablecircularqueue_reserve)
+{
+    Std::GrowableCircularQueue<int> queue;
+
+    queue.ensure_capacity(5);
+    ASSERT(queue.capacity() == 8);
+
+    usize allocations_before = Tests::allocation_count();
+
+    for (int value = 0; value < 8; ++value)
+        queue.enqueue(value);
+
+    ASSERT(Tests::allocation_count() == allocations_before);
+}
+
+static Std::StringView view_of(const std::string& value)
+{
+    return { value.data(), value.size() };
+}
+
+TEST_CASE(growablecircularqueue_random)
+{
+    Std::GrowableCircularQueue<Std::String> queue;
+    std::deque<std::string> reference;
+
+    // We want random, but reproducible operations; pushing is slightly more likely than popping
+    std::mt19937 prng { 1714 };
+    std::uniform_int_distribution<int> distribution { 0, 8 };
+
+    for (int iteration = 0; iteration < 20000; ++iteration) {
+        int operation = distribution(prng);
+
+        if (operation <= 4) {
+            auto value = std::to_string(iteration) + " is stored on the heap";
+
+            if (operation % 2 == 0) {
+                queue.enqueue(view_of(value));
+                reference.push_back(value);
+            } else {
+                queue.enqueue_front(view_of(value));
+                reference.push_front(value);
+            }
+        } else if (!reference.empty()) {
+            if (operation % 2 == 0) {
+                ASSERT(queue.dequeue() == view_of(reference.front()));
+                reference.pop_front();
+            } else {
+                ASSERT(queue.dequeue_back() == view_of(reference.back()));
+                reference.pop_back();
+            }
+        }
+
+        if (iteration % 5000 == 0)
+            queue.shrink_to_fit();
+
+        ASSERT(queue.size() == reference.size());
+    }
+
+    for (usize index = 0; index < reference.size(); ++index)
+        ASSERT(queue[index] == view_of(reference[index]));
+}
+
 TEST_MAIN();
@@ -14,9 +14,9 @@ TEST_CASE(format_has_formatter)
 
 TEST_CASE(format)
 {
-    auto test = []<typename... Parameters>(std::string_view expected, std::string_view format, const Parameters&... parameters) {
+    auto test = []<typename... Parameters>(std::string_view expected, Std::FormatString<typename TypeIdentity<Parameters>::Type...> format, const Parameters&... parameters) {
         Std::StringBuilder builder;
-        builder.appendf(Std::StringView { format.data(), format.size() }, parameters...);
+        builder.appendf(format, parameters...);
 
         ASSERT((expected == std::string_view { builder.view().data(), builder.view().size() }));
     };
@@ -33,6 +33,57 @@ TEST_CASE(format)
     test(std::string_view { "ax\0yb", 5 }, "a{}b", Std::StringView { "x\0y", 3 });
 
     test("a0x00000020a bXYZb c-0x00000004c", "a{}a b{}b c{}c", u32(32), "XYZ", i32(-4));
+
+    test("-0x80", "{}", i8(-128));
+    test("0xffffffffffffffff", "{:x}", u64(0xffffffffffffffffULL));
+    test("", "");
+    test("no placeholders", "no placeholders");
+}
+
+TEST_CASE(format_decimal)
+{
+    auto test = []<typename... Parameters>(std::string_view expected, Std::FormatString<typename TypeIdentity<Parameters>::Type...> format, const Parameters&... parameters) {
+        Std::StringBuilder builder;
+        builder.appendf(format, parameters...);
+
+        ASSERT((expected == std::string_view { builder.view().data(), builder.view().size() }));
+    };
+
+    test("0", "{:d}", u32(0));
+    test("7", "{:d}", u32(7));
+    test("42", "{:d}", i32(42));
+    test("100", "{:d}", u8(100));
+    test("-1", "{:d}", i32(-1));
+    test("-128", "{:d}", i8(-128));
+    test("4294967295", "{:d}", u32(0xffffffff));
+    test("-2147483648", "{:d}", i32(-2147483647 - 1));
+    test("18446744073709551615", "{:d}", u64(0xffffffffffffffffULL));
+    test("-9223372036854775808", "{:d}", i64(-9223372036854775807LL - 1));
+    test("pid 12 exited with 0x00000003", "pid {:d} exited with {}", i32(12), i32(3));
+
+    for (u32 value = 0; value < 100000; value += 7) {
+        Std::StringBuilder builder;
+        builder.appendf("{:d}", value);
+
+        ASSERT((std::to_string(value) == std::string_view { builder.view().data(), builder.view().size() }));
+    }
+}
+
+TEST_CASE(format_escaped_braces)
+{
+    ASSERT(Std::String::format("{{}}") == "{}");
+    ASSERT(Std::String::format("{{{}}}", 'x') == "{x}");
+    ASSERT(Std::String::format("a{{b}}c{}d{{", 'x') == "a{b}cxd{");
+    ASSERT(Std::String::format("}}{}{{{}", 'x', 'y') == "}x{y");
+}
+
+TEST_CASE(format_string_chunks)
+{
+    // The literal chunks and placeholders are determined at compile time
+    constexpr Std::FormatString<int, Std::StringView> format { "abc{:d}d{}" };
+
+    ASSERT(format.style(0) == Std::FormatStyle::Decimal);
+    ASSERT(format.style(1) == Std::FormatStyle::Default);
 }
 
 TEST_MAIN();
@@ -0,0 +1,72 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/Hash.hpp>
+#include <Std/String.hpp>
+#include <Std/HashMap.hpp>
+
+TEST_CASE(hash_string_reference_values)
+{
+    // Reference values of MurmurHash3_x86_32 with seed zero
+    ASSERT(Std::Hash<Std::StringView>::compute("") == 0x00000000);
+    ASSERT(Std::Hash<Std::StringView>::compute("hello") == 0x248bfa47);
+    ASSERT(Std::Hash<Std::StringView>::compute("Hello, world!") == 0xc0363e43);
+    ASSERT(Std::Hash<Std::StringView>::compute("The quick brown fox jumps over the lazy dog") == 0x2e4ff723);
+}
+
+TEST_CASE(hash_string_unaligned)
+{
+    char buffer[64];
+    const char *text = "/bin/Shell.elf";
+
+    u32 expected = Std::Hash<Std::StringView>::compute(text);
+
+    for (usize offset = 0; offset < 8; ++offset) {
+        Std::StringView { text }.strcpy_to({ buffer + offset, sizeof(buffer) - offset });
+        ASSERT(Std::Hash<Std::StringView>::compute(buffer + offset) == expected);
+    }
+}
+
+TEST_CASE(hash_string_matches_view)
+{
+    Std::String string = "/dev/tty";
+
+    ASSERT(Std::Hash<Std::String>::compute(string) == Std::Hash<Std::StringView>::compute("/dev/tty"));
+    ASSERT(string.hash() == Std::Hash<Std::StringView>::compute(string.view()));
+
+    Std::String copy = string;
+    ASSERT(copy.hash() == string.hash());
+
+    Std::String moved = move(copy);
+    ASSERT(moved.hash() == string.hash());
+}
+
+TEST_CASE(hash_string_cache_invalidated)
+{
+    Std::String string = "/dev/tty";
+    u32 hash = string.hash();
+
+    string.data()[5] = 'x';
+
+    ASSERT(string.hash() != hash);
+    ASSERT(string.hash() == Std::Hash<Std::StringView>::compute("/dev/xty"));
+
+    string = "/dev/tty";
+    ASSERT(string.hash() == hash);
+}
+
+TEST_CASE(hash_string_distribution)
+{
+    // Similar keys should spread across the buckets of a small table
+    constexpr usize buckets = 64;
+    usize counts[buckets] = {};
+
+    for (usize index = 0; index < 1024; ++index) {
+        Std::String key = Std::String::format("/dev/tty{}", index);
+        ++counts[key.hash() % buckets];
+    }
+
+    for (usize count : counts)
+        ASSERT(count >= 4 && count <= 32);
+}
+
+TEST_MAIN();
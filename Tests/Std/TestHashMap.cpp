@@ -73,4 +73,29 @@ TEST_CASE(hashmap_iterator)
     ASSERT(did_see_pair_5);
 }
 
+TEST_CASE(hashmap_heterogeneous_lookup)
+{
+    Std::HashMap<Std::String, int> map;
+
+    map.set("bin", 1);
+    map.set("dev", 2);
+    map.set("etc", 3);
+
+    const char *path = "/dev/tty";
+    Std::StringView component { path + 1, 3 };
+
+    ASSERT(map.get(component) != nullptr);
+    ASSERT(*map.get(component) == 2);
+
+    ASSERT(map.get(Std::StringView { path + 5, 3 }) == nullptr);
+
+    *map.get(component) = 4;
+    ASSERT(*map.get("dev") == 4);
+
+    map.remove(Std::StringView { "etc" });
+    ASSERT(map.size() == 2);
+    ASSERT(map.get(Std::StringView { "etc" }) == nullptr);
+    ASSERT(map.get(Std::StringView { "bin" }) != nullptr);
+}
+
 TEST_MAIN();
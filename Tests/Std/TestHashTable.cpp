@@ -2,6 +2,9 @@
 
 #include <Std/HashTable.hpp>
 
+#include <set>
+#include <random>
+
 TEST_CASE(hashtable_int)
 {
     Std::HashTable<u32> hash;
@@ -86,13 +89,13 @@ TEST_CASE(hashtable_iterator)
 
     for (int value : hash.iter()) {
         if (value == 14)
-            ASSERT(std::exchange(did_see_14, true) == false);
+            ASSERT(exchange(did_see_14, true) == false);
         else if (value == 72)
-            ASSERT(std::exchange(did_see_72, true) == false);
+            ASSERT(exchange(did_see_72, true) == false);
         else if (value == 3)
-            ASSERT(std::exchange(did_see_3, true) == false);
+            ASSERT(exchange(did_see_3, true) == false);
         else if (value == 0)
-            ASSERT(std::exchange(did_see_0, true) == false);
+            ASSERT(exchange(did_see_0, true) == false);
         else
             ASSERT_NOT_REACHED();
     }
@@ -103,4 +106,162 @@ TEST_CASE(hashtable_iterator)
     ASSERT(did_see_0);
 }
 
+TEST_CASE(hashtable_random)
+{
+    Std::HashTable<u32> hash;
+    std::set<u32> reference;
+
+    // We want random, but reproducible values; the small range causes many duplicates
+    std::mt19937 prng { 1714 };
+    std::uniform_int_distribution<u32> distribution { 0, 600 };
+
+    for (usize iteration = 0; iteration < 4000; ++iteration) {
+        u32 value = distribution(prng);
+
+        if (iteration % 3 == 2) {
+            hash.remove(value);
+            reference.erase(value);
+        } else {
+            hash.insert(value);
+            reference.insert(value);
+        }
+
+        ASSERT(hash.size() == reference.size());
+    }
+
+    for (u32 value = 0; value <= 600; ++value) {
+        if (reference.contains(value))
+            ASSERT(hash.search(value) != nullptr && *hash.search(value) == value);
+        else
+            ASSERT(hash.search(value) == nullptr);
+    }
+
+    usize count = 0;
+    for (u32 value : hash.iter()) {
+        ASSERT(reference.contains(value));
+        ++count;
+    }
+    ASSERT(count == reference.size());
+}
+
+TEST_CASE(hashtable_collisions_remove)
+{
+    Std::HashTable<A> hash;
+
+    // Everything ends up in the same probe sequence, interleaved with a second one
+    for (int value = 0; value < 20; ++value) {
+        hash.insert({ 5, value });
+        hash.insert({ 6, 100 + value });
+    }
+
+    ASSERT(hash.size() == 40);
+
+    for (int value = 0; value < 20; value += 2)
+        hash.remove({ 5, value });
+
+    ASSERT(hash.size() == 30);
+
+    for (int value = 0; value < 20; ++value) {
+        if (value % 2 == 0)
+            ASSERT(hash.search({ 5, value }) == nullptr);
+        else
+            ASSERT(hash.search({ 5, value }) != nullptr);
+
+        ASSERT(hash.search({ 6, 100 + value }) != nullptr);
+    }
+}
+
+TEST_CASE(hashtable_reserve)
+{
+    Std::HashTable<u32> hash;
+
+    ASSERT(hash.capacity() == 0);
+
+    hash.reserve(100);
+
+    usize capacity = hash.capacity();
+    ASSERT(capacity >= 100);
+
+    for (u32 value = 0; value < 100; ++value)
+        hash.insert(value);
+
+    ASSERT(hash.capacity() == capacity);
+    ASSERT(hash.size() == 100);
+
+    hash.clear();
+
+    ASSERT(hash.size() == 0);
+    ASSERT(hash.search(42) == nullptr);
+}
+
+struct C {
+    static inline int m_alive = 0;
+
+    C(u32 value)
+        : m_value(value)
+    {
+        ++m_alive;
+    }
+    C(const C& other)
+        : m_value(other.m_value)
+    {
+        ++m_alive;
+    }
+    ~C()
+    {
+        --m_alive;
+    }
+
+    C& operator=(const C&) = default;
+
+    bool operator==(const C& other) const
+    {
+        return m_value == other.m_value;
+    }
+
+    u32 hash() const
+    {
+        return m_value;
+    }
+
+    u32 m_value;
+};
+
+TEST_CASE(hashtable_destructor)
+{
+    {
+        Std::HashTable<C> hash;
+
+        for (u32 value = 0; value < 64; ++value)
+            hash.insert({ value });
+
+        ASSERT(C::m_alive == 64);
+
+        hash.remove({ 3 });
+        hash.remove({ 11 });
+
+        ASSERT(C::m_alive == 62);
+    }
+
+    ASSERT(C::m_alive == 0);
+}
+
+TEST_CASE(hashtable_move)
+{
+    Std::HashTable<u32> hash1;
+    hash1.insert(1);
+    hash1.insert(2);
+
+    Std::HashTable<u32> hash2 { move(hash1) };
+
+    ASSERT(hash1.size() == 0);
+    ASSERT(hash1.search(1) == nullptr);
+    for ([[maybe_unused]] u32 value : hash1.iter())
+        ASSERT_NOT_REACHED();
+
+    ASSERT(hash2.size() == 2);
+    ASSERT(hash2.search(1) != nullptr);
+    ASSERT(hash2.search(2) != nullptr);
+}
+
 TEST_MAIN();
@@ -0,0 +1,168 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/LogBuffer.hpp>
+
+#include <mutex>
+#include <thread>
+#include <string>
+#include <utility>
+
+struct NoGuard {
+};
+
+// Simulates an interrupt that fires while the guard is released, after a message was reserved but before it is committed
+struct InterruptingGuard {
+    static inline std::function<void()> m_interrupt;
+
+    ~InterruptingGuard()
+    {
+        if (m_interrupt)
+            std::exchange(m_interrupt, nullptr)();
+    }
+};
+
+struct MutexGuard {
+    static inline std::mutex m_mutex;
+
+    MutexGuard() { m_mutex.lock(); }
+    ~MutexGuard() { m_mutex.unlock(); }
+};
+
+template<typename LogBuffer>
+static std::vector<std::string> drain_all(LogBuffer& buffer)
+{
+    std::vector<std::string> messages;
+    buffer.drain([&](Std::StringView message) {
+        messages.emplace_back(message.data(), message.size());
+    });
+    return messages;
+}
+
+TEST_CASE(logbuffer)
+{
+    Std::LogBuffer<64, NoGuard> buffer;
+
+    ASSERT(buffer.is_empty());
+
+    ASSERT(buffer.try_append("foo"));
+    ASSERT(buffer.try_append(""));
+    ASSERT(buffer.try_append("hello world"));
+
+    ASSERT(!buffer.is_empty());
+    ASSERT((drain_all(buffer) == std::vector<std::string> { "foo", "", "hello world" }));
+
+    ASSERT(buffer.is_empty());
+    ASSERT(buffer.dropped() == 0);
+    ASSERT(drain_all(buffer).empty());
+}
+
+TEST_CASE(logbuffer_wrap)
+{
+    Std::LogBuffer<64, NoGuard> buffer;
+
+    // Every record takes 16 bytes, thus the records do not line up with the end of the buffer
+    for (usize round = 0; round < 100; ++round) {
+        auto message = std::to_string(round) + "-abcdefghi";
+        message.resize(10, '.');
+
+        ASSERT(buffer.try_append({ message.data(), message.size() }));
+        ASSERT(buffer.try_append("x"));
+
+        ASSERT((drain_all(buffer) == std::vector<std::string> { message, "x" }));
+    }
+
+    ASSERT(buffer.dropped() == 0);
+}
+
+TEST_CASE(logbuffer_overflow)
+{
+    Std::LogBuffer<64, NoGuard> buffer;
+
+    // Each record takes 12 bytes, five fit
+    for (usize index = 0; index < 5; ++index)
+        ASSERT(buffer.try_append("12345678"));
+
+    ASSERT(!buffer.try_append("12345678"));
+    ASSERT(!buffer.try_append("1"));
+    ASSERT(buffer.dropped() == 2);
+
+    // Larger than half of the buffer
+    ASSERT(!buffer.try_append("this message is way too long for a buffer of 64 bytes"));
+    ASSERT(buffer.dropped() == 3);
+
+    ASSERT(drain_all(buffer).size() == 5);
+    ASSERT(buffer.try_append("12345678"));
+    ASSERT(drain_all(buffer).size() == 1);
+}
+
+TEST_CASE(logbuffer_uncommitted)
+{
+    Std::LogBuffer<64, InterruptingGuard> buffer;
+
+    std::vector<std::string> drained_during_interrupt;
+
+    InterruptingGuard::m_interrupt = [&] {
+        ASSERT(buffer.try_append("interrupt"));
+
+        // The first message was reserved but is not committed, nothing can be read yet
+        drained_during_interrupt = drain_all(buffer);
+    };
+
+    ASSERT(buffer.try_append("thread"));
+
+    ASSERT(drained_during_interrupt.empty());
+    ASSERT((drain_all(buffer) == std::vector<std::string> { "thread", "interrupt" }));
+}
+
+TEST_CASE(logbuffer_threads)
+{
+    constexpr usize producer_count = 4;
+    constexpr usize message_count = 20000;
+
+    Std::LogBuffer<1024, MutexGuard> buffer;
+
+    std::atomic<usize> producers_done = 0;
+    std::vector<std::thread> producers;
+
+    for (usize producer = 0; producer < producer_count; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (usize index = 0; index < message_count; ++index) {
+                auto message = std::to_string(producer) + ":" + std::to_string(index);
+                buffer.try_append({ message.data(), message.size() });
+            }
+
+            ++producers_done;
+        });
+    }
+
+    usize received = 0;
+    std::vector<isize> last_index(producer_count, -1);
+
+    auto consume = [&](Std::StringView message) {
+        std::string value { message.data(), message.size() };
+        usize separator = value.find(':');
+        ASSERT(separator != std::string::npos);
+
+        usize producer = std::stoul(value.substr(0, separator));
+        isize index = std::stol(value.substr(separator + 1));
+
+        // Messages of one producer may be dropped but never reordered
+        ASSERT(producer < producer_count);
+        ASSERT(index > last_index[producer]);
+        last_index[producer] = index;
+
+        ++received;
+    };
+
+    while (producers_done < producer_count)
+        buffer.drain(consume);
+    buffer.drain(consume);
+
+    for (auto& thread : producers)
+        thread.join();
+
+    ASSERT(buffer.is_empty());
+    ASSERT(received + buffer.dropped() == producer_count * message_count);
+}
+
+TEST_MAIN();
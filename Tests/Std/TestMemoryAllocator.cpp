@@ -64,4 +64,421 @@ TEST_CASE(memoryallocator_death_by_a_thousand_cuts)
     ASSERT(stats_before.m_largest_continous_block == stats_after.m_largest_continous_block);
 }
 
+TEST_CASE(memoryallocator_reallocate_null)
+{
+    std::array<uint8_t, 0x200> heap;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+
+    u8 *pointer = mem.reallocate(nullptr, 32);
+    ASSERT(pointer != nullptr);
+
+    std::memset(pointer, 0x11, 32);
+
+    mem.deallocate(pointer);
+}
+
+TEST_CASE(memoryallocator_try_reallocate_in_place)
+{
+    std::array<uint8_t, 0x200> heap;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+
+    u8 *pointer1 = mem.allocate(32);
+    u8 *pointer2 = mem.allocate(32);
+    u8 *pointer3 = mem.allocate(32);
+
+    auto before = mem.statistics();
+
+    // The following block is in use
+    ASSERT(!mem.try_reallocate_in_place(pointer1, 64));
+
+    // Shrinking always works
+    ASSERT(mem.try_reallocate_in_place(pointer1, 16));
+
+    mem.deallocate(pointer2);
+
+    // Now we can grow into the freed block, this does not consume a header
+    ASSERT(mem.try_reallocate_in_place(pointer1, 48));
+    std::memset(pointer1, 0x22, 48);
+
+    ASSERT(!mem.try_reallocate_in_place(pointer1, 128));
+
+    // The last block can grow into the remainder of the heap
+    ASSERT(mem.try_reallocate_in_place(pointer3, 64));
+    std::memset(pointer3, 0x33, 64);
+
+    mem.deallocate(pointer1);
+    mem.deallocate(pointer3);
+
+    auto after = mem.statistics();
+    ASSERT(after.m_avaliable_memory > before.m_avaliable_memory);
+
+    // Everything was merged again
+    u8 *pointer4 = mem.allocate(heap.size() - 64);
+    ASSERT(pointer4 != nullptr);
+}
+
+TEST_CASE(memoryallocator_size_classes)
+{
+    alignas(16) std::array<uint8_t, 0x2000> heap;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+
+    auto before = mem.statistics();
+
+    // Blocks of the same size class are placed next to each other, with only a tag word in between
+    u8 *pointer1 = mem.allocate(5);
+    u8 *pointer2 = mem.allocate(8);
+    ASSERT(pointer2 == pointer1 + 8 + sizeof(usize));
+
+    // Slabs are only carved out once per size class
+    auto middle = mem.statistics();
+    ASSERT(middle.m_size_class_memory > 0);
+
+    u8 *pointer3 = mem.allocate(100);
+    std::memset(pointer1, 0x11, 8);
+    std::memset(pointer2, 0x22, 8);
+    std::memset(pointer3, 0x33, 100);
+
+    // Freed slots are reused first
+    mem.deallocate(pointer1);
+    ASSERT(mem.allocate(7) == pointer1);
+
+    // Growing beyond the size class moves the block and keeps the content
+    u8 *pointer4 = mem.reallocate(pointer2, 200);
+    ASSERT(pointer4 != pointer2);
+    for (usize index = 0; index < 8; ++index)
+        ASSERT(pointer4[index] == 0x22);
+
+    // Slots never grow in place, but can always shrink
+    ASSERT(mem.try_reallocate_in_place(pointer3, 128));
+    ASSERT(!mem.try_reallocate_in_place(pointer3, 129));
+    ASSERT(mem.reallocate(pointer3, 64) == pointer3);
+
+    mem.deallocate(pointer1);
+    mem.deallocate(pointer3);
+    mem.deallocate(pointer4);
+
+    // Empty slabs are returned to the free list
+    auto after = mem.statistics();
+    ASSERT(after.m_size_class_memory == 0);
+    ASSERT(after.m_avaliable_memory == before.m_avaliable_memory);
+    ASSERT(after.m_largest_continous_block == before.m_largest_continous_block);
+}
+
+TEST_CASE(memoryallocator_size_classes_disabled)
+{
+    alignas(16) std::array<uint8_t, 0x2000> heap;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+
+    u8 *slot = mem.allocate(16);
+
+    mem.m_use_size_classes = false;
+
+    // Without size classes, small blocks carry a full header
+    u8 *pointer1 = mem.allocate(24);
+    u8 *pointer2 = mem.allocate(24);
+    ASSERT(mem.statistics().m_size_class_memory > 0);
+    ASSERT(pointer2 == pointer1 + 24 + sizeof(usize));
+
+    // Blocks are still recognized after switching
+    mem.deallocate(slot);
+    mem.deallocate(pointer1);
+    mem.deallocate(pointer2);
+
+    ASSERT(mem.statistics().m_size_class_memory == 0);
+}
+
+TEST_CASE(memoryallocator_size_classes_random)
+{
+    alignas(16) std::array<uint8_t, 0x10000> heap;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+    auto before = mem.statistics();
+
+    std::mt19937 prng { 42 };
+
+    // Every allocation is filled with a pattern derived from its index to detect overlapping blocks
+    std::vector<std::pair<u8*, usize>> allocations;
+
+    auto check = [&](usize index) {
+        auto [pointer, size] = allocations[index];
+        for (usize offset = 0; offset < size; ++offset)
+            ASSERT(pointer[offset] == u8(usize(pointer) + offset));
+    };
+
+    for (usize round = 0; round < 20000; ++round) {
+        if (allocations.size() < 200 && (allocations.empty() || prng() % 2 == 0)) {
+            usize size = prng() % 4 == 0 ? prng() % 512 : prng() % 140;
+
+            u8 *pointer = mem.allocate(size);
+            for (usize offset = 0; offset < size; ++offset)
+                pointer[offset] = u8(usize(pointer) + offset);
+
+            allocations.emplace_back(pointer, size);
+        } else {
+            usize index = prng() % allocations.size();
+            check(index);
+
+            mem.deallocate(allocations[index].first);
+            allocations.erase(allocations.begin() + index);
+        }
+    }
+
+    for (usize index = 0; index < allocations.size(); ++index)
+        check(index);
+    for (auto [pointer, size] : allocations)
+        mem.deallocate(pointer);
+
+    auto after = mem.statistics();
+    ASSERT(after.m_size_class_memory == 0);
+    ASSERT(after.m_largest_continous_block == before.m_largest_continous_block);
+}
+
+TEST_CASE(memoryallocator_reallocate_in_place)
+{
+    alignas(16) std::array<uint8_t, 0x1000> heap;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+    mem.m_use_size_classes = false;
+
+    u8 *pointer1 = mem.allocate(256);
+    u8 *pointer2 = mem.allocate(256);
+    std::memset(pointer1, 0x11, 256);
+    std::memset(pointer2, 0x22, 256);
+
+    // The last block grows into the rest of the heap without moving
+    u8 *pointer3 = mem.reallocate(pointer2, 1024);
+    ASSERT(pointer3 == pointer2);
+    for (usize index = 0; index < 256; ++index)
+        ASSERT(pointer3[index] == 0x22);
+    mem.heap_check();
+
+    // The following block is in use, thus the block has to move
+    u8 *pointer4 = mem.reallocate(pointer1, 512);
+    ASSERT(pointer4 != pointer1);
+    for (usize index = 0; index < 256; ++index)
+        ASSERT(pointer4[index] == 0x11);
+    mem.heap_check();
+
+    // Now the following block is free and the first block grows into it
+    u8 *pointer5 = mem.allocate(64);
+    ASSERT(pointer5 == pointer1);
+    std::memset(pointer5, 0x55, 64);
+
+    u8 *pointer6 = mem.reallocate(pointer5, 200);
+    ASSERT(pointer6 == pointer5);
+    for (usize index = 0; index < 64; ++index)
+        ASSERT(pointer6[index] == 0x55);
+    mem.heap_check();
+
+    mem.deallocate(pointer3);
+    mem.deallocate(pointer4);
+    mem.deallocate(pointer6);
+    mem.heap_check();
+}
+
+TEST_CASE(memoryallocator_reallocate_shrink)
+{
+    alignas(16) std::array<uint8_t, 0x1000> heap;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+    mem.m_use_size_classes = false;
+
+    u8 *pointer1 = mem.allocate(1024);
+    u8 *pointer2 = mem.allocate(64);
+    std::memset(pointer1, 0x11, 1024);
+
+    auto before = mem.statistics();
+
+    // Shrinking a little keeps the block as is
+    ASSERT(mem.reallocate(pointer1, 1000) == pointer1);
+    ASSERT(mem.statistics().m_avaliable_memory == before.m_avaliable_memory);
+
+    // Shrinking substantially returns the tail, even if the following block is in use
+    ASSERT(mem.reallocate(pointer1, 128) == pointer1);
+    for (usize index = 0; index < 128; ++index)
+        ASSERT(pointer1[index] == 0x11);
+    mem.heap_check();
+
+    auto after = mem.statistics();
+    ASSERT(after.m_avaliable_memory >= before.m_avaliable_memory + 1024 - 128 - sizeof(usize));
+
+    // The tail can be used by other allocations
+    u8 *pointer3 = mem.allocate(512);
+    ASSERT(pointer3 > pointer1 && pointer3 < pointer2);
+    mem.heap_check();
+
+    mem.deallocate(pointer1);
+    mem.deallocate(pointer2);
+    mem.deallocate(pointer3);
+    mem.heap_check();
+}
+
+TEST_CASE(memoryallocator_coalesce)
+{
+    alignas(16) std::array<uint8_t, 0x1000> heap;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+    mem.m_use_size_classes = false;
+
+    auto before = mem.statistics();
+
+    u8 *pointer1 = mem.allocate(200);
+    u8 *pointer2 = mem.allocate(200);
+    u8 *pointer3 = mem.allocate(200);
+    u8 *pointer4 = mem.allocate(200);
+    mem.heap_check();
+
+    // Freeing the outer blocks first leaves holes that are merged with the middle blocks later
+    mem.deallocate(pointer1);
+    mem.deallocate(pointer3);
+    mem.heap_check();
+
+    mem.deallocate(pointer2);
+    mem.heap_check();
+
+    auto middle = mem.statistics();
+    ASSERT(middle.m_largest_continous_block >= 600);
+
+    mem.deallocate(pointer4);
+    mem.heap_check();
+
+    auto after = mem.statistics();
+    ASSERT(after.m_avaliable_memory == before.m_avaliable_memory);
+    ASSERT(after.m_largest_continous_block == before.m_largest_continous_block);
+}
+
+TEST_CASE(memoryallocator_coalesce_random)
+{
+    alignas(16) std::array<uint8_t, 0x8000> heap;
+
+    for (bool use_size_classes : { false, true }) {
+        Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+        mem.m_use_size_classes = use_size_classes;
+
+        auto before = mem.statistics();
+
+        std::mt19937 prng { 1337 };
+        std::vector<std::pair<u8*, usize>> allocations;
+
+        for (usize round = 0; round < 5000; ++round) {
+            usize action = prng() % 8;
+
+            if (allocations.empty() || (action < 4 && allocations.size() < 100)) {
+                usize size = 1 + prng() % 300;
+
+                u8 *pointer = mem.allocate(size);
+                std::memset(pointer, u8(size), size);
+
+                allocations.emplace_back(pointer, size);
+            } else if (action < 7) {
+                usize index = prng() % allocations.size();
+                auto [pointer, size] = allocations[index];
+
+                for (usize offset = 0; offset < size; ++offset)
+                    ASSERT(pointer[offset] == u8(size));
+
+                mem.deallocate(pointer);
+                allocations.erase(allocations.begin() + index);
+            } else {
+                // Growing in place must not corrupt the following blocks
+                auto& [pointer, size] = allocations[prng() % allocations.size()];
+                usize new_size = size + prng() % 64;
+
+                if (mem.try_reallocate_in_place(pointer, new_size)) {
+                    size = new_size;
+                    std::memset(pointer, u8(size), size);
+                }
+            }
+
+            mem.heap_check();
+        }
+
+        for (auto [pointer, size] : allocations)
+            mem.deallocate(pointer);
+        mem.heap_check();
+
+        // Everything was merged back into a single block
+        auto after = mem.statistics();
+        ASSERT(after.m_avaliable_memory == before.m_avaliable_memory);
+        ASSERT(after.m_largest_continous_block == before.m_largest_continous_block);
+    }
+}
+
+TEST_CASE(memoryallocator_regions)
+{
+    alignas(16) std::array<uint8_t, 0x400> heap;
+    alignas(16) std::array<uint8_t, 0x1000> region1;
+    alignas(16) std::array<uint8_t, 0x1000> region2;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+
+    // The initial heap can not serve this
+    ASSERT(mem.try_allocate(0x800) == nullptr);
+
+    // Unaligned regions are fine, too
+    mem.add_region({ region1.data() + 1, region1.size() - 1 });
+    mem.add_region({ region2.data(), region2.size() });
+    ASSERT(mem.heap_size() == heap.size() + region1.size() + region2.size() - 1);
+    mem.heap_check();
+
+    u8 *pointer1 = mem.allocate(0x800);
+    u8 *pointer2 = mem.allocate(0x800);
+    u8 *pointer3 = mem.allocate(0x100);
+    mem.heap_check();
+
+    // Blocks of different regions are never merged
+    ASSERT(mem.take_free_region().is_empty());
+    mem.deallocate(pointer3);
+    mem.deallocate(pointer1);
+    mem.heap_check();
+
+    // Only a region that is entirely free can be taken
+    Std::Bytes region = mem.take_free_region();
+    ASSERT(!region.is_empty());
+    ASSERT(mem.take_free_region().is_empty());
+    mem.heap_check();
+
+    mem.deallocate(pointer2);
+    Std::Bytes other_region = mem.take_free_region();
+    ASSERT(!other_region.is_empty() && other_region.data() != region.data());
+    ASSERT(mem.take_free_region().is_empty());
+
+    ASSERT(mem.heap_size() == heap.size());
+    mem.heap_check();
+}
+
+TEST_CASE(memoryallocator_release_regions)
+{
+    alignas(16) std::array<uint8_t, 0x400> heap;
+    alignas(16) std::array<uint8_t, 0x1000> region1;
+    alignas(16) std::array<uint8_t, 0x1000> region2;
+
+    Std::MemoryAllocator mem { { heap.data(), heap.size() } };
+    mem.add_region({ region1.data(), region1.size() });
+    mem.add_region({ region2.data(), region2.size() });
+
+    // Blocks that are still allocated do not matter
+    mem.allocate(0x800);
+    mem.allocate(0x800);
+    mem.allocate(0x100);
+
+    std::vector<uint8_t*> released;
+    mem.release_regions([&](Std::Bytes bytes) {
+        // The allocator must not touch the region after handing it out
+        std::memset(bytes.data(), 0xff, bytes.size());
+        released.push_back(bytes.data());
+    });
+
+    std::sort(released.begin(), released.end());
+    std::vector<uint8_t*> expected { region1.data(), region2.data() };
+    std::sort(expected.begin(), expected.end());
+
+    ASSERT(released == expected);
+    ASSERT(mem.heap_size() == heap.size());
+}
+
 TEST_MAIN();
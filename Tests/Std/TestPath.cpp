@@ -2,6 +2,9 @@
 
 #include <Std/Path.hpp>
 
+#include <string>
+#include <vector>
+
 TEST_CASE(path)
 {
     Std::Path path { "/foo/bar/baz" };
@@ -84,4 +87,111 @@ TEST_CASE(path_absolute_regression)
     ASSERT(path2.is_absolute() == true);
 }
 
+TEST_CASE(path_normalize)
+{
+    auto test = [](const char *input, const char *expected, bool is_absolute) {
+        Std::Path path { input };
+        ASSERT(path.view() == expected);
+        ASSERT(path.is_absolute() == is_absolute);
+    };
+
+    test("/", "/", true);
+    test("//", "/", true);
+    test("/foo//bar/", "/foo/bar", true);
+    test("/./foo/.", "/foo", true);
+    test("/foo/../bar", "/bar", true);
+    test("/foo/bar/../..", "/", true);
+    test("/..", "/", true);
+    test("/../foo", "/foo", true);
+
+    test(".", "", false);
+    test("./foo", "foo", false);
+    test("foo/..", "", false);
+    test("..", "..", false);
+    test("../..", "../..", false);
+    test("../foo/../bar", "../bar", false);
+    test("foo/../../bar", "../bar", false);
+}
+
+TEST_CASE(path_components)
+{
+    Std::Path path { "/foo//bar/./baz/../qux" };
+
+    std::vector<std::string> components;
+    for (Std::StringView component : path.components())
+        components.emplace_back(component.data(), component.size());
+
+    ASSERT((components == std::vector<std::string> { "foo", "bar", "qux" }));
+
+    ASSERT(Std::Path { "/" }.components().size() == 0);
+    ASSERT(Std::Path { "." }.components().size() == 0);
+}
+
+TEST_CASE(path_join)
+{
+    Std::Path working_directory { "/home/user" };
+
+    ASSERT((working_directory / "file").view() == "/home/user/file");
+    ASSERT((working_directory / "../other").view() == "/home/other");
+    ASSERT((working_directory / "../../../..").view() == "/");
+    ASSERT((working_directory / ".").view() == "/home/user");
+
+    ASSERT((Std::Path { "a" } / "../../b").view() == "../b");
+    ASSERT((Std::Path { "a/b" } / "..").parent().view() == "");
+
+    // The components must still refer to the buffer after it moved into a new path
+    Std::Path joined = working_directory / "a/b";
+    ASSERT(joined.components().size() == 4);
+    ASSERT(joined.components()[3] == "b");
+    ASSERT(joined.filename() == "b");
+}
+
+TEST_CASE(path_allocations)
+{
+    Std::Path working_directory { "/home/user" };
+
+    size_t before = Tests::allocation_count();
+    {
+        Std::Path path = working_directory / "../bin/Shell.elf";
+        ASSERT(path.view() == "/home/bin/Shell.elf");
+
+        Std::Path parent = path.parent();
+        ASSERT(parent.view() == "/home/bin");
+        ASSERT(path.filename() == "Shell.elf");
+
+        path = parent;
+        ASSERT(path.view() == "/home/bin");
+    }
+    ASSERT(Tests::allocation_count() - before == 0);
+
+    // Long paths need a single allocation for the buffer, the components themselves are never copied
+    Std::StringView long_name { "/a-rather-long-directory-name/that-does-not-fit/buffer" };
+
+    before = Tests::allocation_count();
+    {
+        Std::Path path { long_name };
+        ASSERT(path.view() == long_name);
+        ASSERT(path.filename() == "buffer");
+    }
+    ASSERT(Tests::allocation_count() - before == 1);
+}
+
+TEST_CASE(path_throughput)
+{
+    // Resolves relative paths like the system calls do, none of this may touch the heap
+    Std::Path working_directory { "/bin" };
+    const char *names[] = { "Shell.elf", "./Editor.elf", "../dev/tty", "../bin/../bin/Example.elf" };
+
+    size_t before = Tests::allocation_count();
+
+    usize total_size = 0;
+    for (usize round = 0; round < 10000; ++round) {
+        Std::Path path = working_directory / names[round % 4];
+        total_size += path.filename().size() + path.parent().view().size();
+    }
+
+    ASSERT(Tests::allocation_count() == before);
+    ASSERT(total_size == 2500 * ((9 + 4) + (10 + 4) + (3 + 4) + (11 + 4)));
+}
+
 TEST_MAIN();
@@ -30,7 +30,7 @@ TEST_CASE(sortedset_tree)
     set.insert(15);
     set.insert(4);
 
-    ASSERT(Std::String::format("{}", set) == "(nil 0x00000001 (0x00000002 0x00000003 (0x00000004 0x00000007 (nil 0x00000009 0x0000000f))))");
+    ASSERT(Std::String::format("{}", set) == "(0x00000001 0x00000002 (0x00000003 0x00000004 (0x00000007 0x00000009 0x0000000f)))");
 }
 
 TEST_CASE(sortedset_remove_1)
@@ -72,11 +72,11 @@ TEST_CASE(sortedset_remove_2)
     set.insert(10);
     set.insert(13);
 
-    ASSERT(Std::String::format("{}", set) == "(0x00000004 0x00000007 ((0x00000008 0x00000009 0x0000000a) 0x0000000b 0x0000000d))");
+    ASSERT(Std::String::format("{}", set) == "(0x00000004 0x00000007 (0x00000008 0x00000009 (0x0000000a 0x0000000b 0x0000000d)))");
 
     set.remove(11);
 
-    ASSERT(Std::String::format("{}", set) == "(0x00000004 0x00000007 ((0x00000008 0x00000009 0x0000000a) 0x0000000d nil))");
+    ASSERT(Std::String::format("{}", set) == "(0x00000004 0x00000007 (0x00000008 0x00000009 (0x0000000a 0x0000000d nil)))");
 }
 
 TEST_CASE(sortedset_remove_3)
@@ -87,11 +87,11 @@ TEST_CASE(sortedset_remove_3)
     set.insert(2);
     set.insert(3);
 
-    ASSERT(Std::String::format("{}", set) == "(nil 0x00000001 (nil 0x00000002 0x00000003))");
+    ASSERT(Std::String::format("{}", set) == "(0x00000001 0x00000002 0x00000003)");
 
     set.remove(2);
 
-    ASSERT(Std::String::format("{}", set) == "(nil 0x00000001 0x00000003)");
+    ASSERT(Std::String::format("{}", set) == "(0x00000001 0x00000003 nil)");
 }
 
 TEST_CASE(sortedset_remove_4)
@@ -102,11 +102,11 @@ TEST_CASE(sortedset_remove_4)
     set.insert(3);
     set.insert(2);
 
-    ASSERT(Std::String::format("{}", set) == "(nil 0x00000001 (0x00000002 0x00000003 nil))");
+    ASSERT(Std::String::format("{}", set) == "(0x00000001 0x00000002 0x00000003)");
 
     set.remove(3);
 
-    ASSERT(Std::String::format("{}", set) == "(nil 0x00000001 0x00000002)");
+    ASSERT(Std::String::format("{}", set) == "(0x00000001 0x00000002 nil)");
 }
 
 TEST_CASE(sortedset_remove_5)
@@ -202,7 +202,7 @@ TEST_CASE(sortedset_custom_1)
     set.insert({ 1, 4 });
     set.insert({ 1, 2 });
 
-    ASSERT(Std::String::format("{}", set) == "([0x00000001.0x00000002] [0x00000001.0x00000003] ([0x00000001.0x00000004] [0x00000004.0x00000006] nil))");
+    ASSERT(Std::String::format("{}", set) == "(([0x00000001.0x00000002] [0x00000001.0x00000003] nil) [0x00000001.0x00000004] [0x00000004.0x00000006])");
 }
 
 struct B {
@@ -236,11 +236,11 @@ TEST_CASE(sortedset_custom_2)
     set.insert({ 13, "bar" });
     set.insert({ -4, "x" });
 
-    ASSERT(Std::String::format("{}", set) == "(([-0x00000004.x] [0x0000000d.bar] nil) [0x0000002a.foo] nil)");
+    ASSERT(Std::String::format("{}", set) == "([-0x00000004.x] [0x0000000d.bar] [0x0000002a.foo])");
 
     set.insert({ 13, "baz" });
 
-    ASSERT(Std::String::format("{}", set) == "(([-0x00000004.x] [0x0000000d.baz] nil) [0x0000002a.foo] nil)");
+    ASSERT(Std::String::format("{}", set) == "([-0x00000004.x] [0x0000000d.baz] [0x0000002a.foo])");
 
     set.remove({ 13, "y" });
 
@@ -331,4 +331,175 @@ TEST_CASE(sortedset_move)
     ASSERT(iter.is_end());
 }
 
+// log2(size + 1) rounded up, times two
+static usize red_black_depth_bound(usize size)
+{
+    usize log = 0;
+    while ((usize(1) << log) < size + 1)
+        ++log;
+    return 2 * log;
+}
+
+TEST_CASE(sortedset_ascending_depth)
+{
+    Std::SortedSet<int> set;
+
+    for (int value = 0; value < 1024; ++value) {
+        set.insert(value);
+
+        ASSERT(set.depth() <= red_black_depth_bound(set.size()));
+    }
+
+    set.verify_invariants();
+
+    ASSERT(set.size() == 1024);
+    ASSERT(set.depth() <= 2 * 11);
+
+    for (int value = 0; value < 1024; ++value) {
+        ASSERT(set.search(value) != nullptr);
+        ASSERT(*set.search(value) == value);
+    }
+}
+
+TEST_CASE(sortedset_descending_depth)
+{
+    Std::SortedSet<int> set;
+
+    for (int value = 1023; value >= 0; --value)
+        set.insert(value);
+
+    set.verify_invariants();
+
+    ASSERT(set.size() == 1024);
+    ASSERT(set.depth() <= red_black_depth_bound(set.size()));
+
+    int expected = 0;
+    for (int value : set.inorder())
+        ASSERT(value == expected++);
+    ASSERT(expected == 1024);
+}
+
+TEST_CASE(sortedset_zigzag_depth)
+{
+    Std::SortedSet<int> set;
+
+    // Alternate between both ends, which degenerates an unbalanced tree into a zigzag
+    for (int value = 0; value < 512; ++value) {
+        set.insert(value);
+        set.insert(2047 - value);
+    }
+
+    set.verify_invariants();
+
+    ASSERT(set.size() == 1024);
+    ASSERT(set.depth() <= red_black_depth_bound(set.size()));
+}
+
+TEST_CASE(sortedset_remove_balanced)
+{
+    Std::SortedSet<int> set;
+
+    for (int value = 0; value < 1024; ++value)
+        set.insert(value);
+
+    // Remove every value in the lower half and every other value in the upper half
+    for (int value = 0; value < 512; ++value) {
+        set.remove(value);
+        set.remove(512 + 2 * (value / 2));
+
+        if (value % 64 == 0)
+            set.verify_invariants();
+    }
+
+    set.verify_invariants();
+
+    ASSERT(set.size() == 256);
+    ASSERT(set.depth() <= red_black_depth_bound(set.size()));
+
+    for (int value = 0; value < 1024; ++value) {
+        if (value >= 512 && value % 2 == 1)
+            ASSERT(set.search(value) != nullptr);
+        else
+            ASSERT(set.search(value) == nullptr);
+    }
+
+    for (int value = 0; value < 1024; ++value)
+        set.remove(value);
+
+    set.verify_invariants();
+
+    ASSERT(set.size() == 0);
+    ASSERT(set.depth() == 0);
+}
+
+TEST_CASE(sortedset_build_from_sorted)
+{
+    for (usize size = 0; size < 70; ++size) {
+        std::vector<int> values;
+        for (usize index = 0; index < size; ++index)
+            values.push_back(int(3 * index));
+
+        Std::SortedSet<int> set;
+        set.insert(-1);
+
+        set.build_from_sorted({ values.data(), values.size() });
+
+        set.verify_invariants();
+
+        ASSERT(set.size() == size);
+        ASSERT(set.search(-1) == nullptr);
+        ASSERT(set.depth() <= red_black_depth_bound(set.size()));
+
+        usize index = 0;
+        for (int value : set.inorder())
+            ASSERT(value == values[index++]);
+        ASSERT(index == size);
+
+        // The tree must remain valid when modified afterwards
+        set.insert(1);
+        set.remove(0);
+        set.verify_invariants();
+    }
+}
+
+TEST_CASE(sortedset_lower_bound)
+{
+    Std::SortedSet<int> set;
+
+    for (int value = 0; value < 100; value += 10)
+        set.insert(value);
+
+    auto iter = set.lower_bound(35);
+    ASSERT(*iter++ == 40);
+    ASSERT(*iter++ == 50);
+
+    iter = set.lower_bound(50);
+    ASSERT(*iter == 50);
+
+    ASSERT(*set.lower_bound(-5) == 0);
+    ASSERT(set.lower_bound(91).is_end());
+}
+
+TEST_CASE(sortedset_range)
+{
+    Std::SortedSet<int> set;
+
+    for (int value = 0; value < 100; value += 10)
+        set.insert(value);
+
+    std::vector<int> values;
+    for (int value : set.range(15, 60))
+        values.push_back(value);
+
+    ASSERT((values == std::vector<int> { 20, 30, 40, 50 }));
+
+    values.clear();
+    for (int value : set.range(60, 1000))
+        values.push_back(value);
+
+    ASSERT((values == std::vector<int> { 60, 70, 80, 90 }));
+
+    ASSERT(set.range(41, 49).is_end());
+}
+
 TEST_MAIN();
@@ -66,4 +66,37 @@ TEST_CASE(span_iterator)
         ASSERT(*iter++ == buffer[index]);
 }
 
+TEST_CASE(span_copy_to_returns_count)
+{
+    std::array<u8, 16> source;
+    std::array<u8, 64> destination {};
+
+    for (size_t index = 0; index < source.size(); ++index)
+        source[index] = index + 1;
+
+    auto bytes = Std::ReadonlyBytes { source.data(), source.size() };
+
+    ASSERT(bytes.copy_to({ destination.data(), destination.size() }) == 16);
+    ASSERT(destination[15] == 16 && destination[16] == 0);
+
+    destination.fill(0);
+
+    ASSERT(bytes.copy_trimmed_to({ destination.data(), 10 }) == 10);
+    ASSERT(destination[9] == 10 && destination[10] == 0);
+}
+
+TEST_CASE(span_copy_to_elements)
+{
+    std::array<u32, 4> source { 0x11111111, 0x22222222, 0x33333333, 0x44444444 };
+    std::array<u32, 4> destination {};
+
+    auto span = Std::Span<const u32> { source.data(), source.size() };
+
+    // Copies elements, not bytes
+    ASSERT(span.copy_trimmed_to({ destination.data(), 3 }) == 3);
+    ASSERT(destination[0] == 0x11111111);
+    ASSERT(destination[2] == 0x33333333);
+    ASSERT(destination[3] == 0);
+}
+
 TEST_MAIN();
@@ -0,0 +1,105 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/String.hpp>
+#include <Std/Path.hpp>
+
+TEST_CASE(string_inline)
+{
+    size_t before = Tests::allocation_count();
+
+    Std::String empty;
+    ASSERT(empty.size() == 0);
+    ASSERT(empty.cstring()[0] == 0);
+
+    Std::String string = "Shell.elf";
+    ASSERT(string.size() == 9);
+    ASSERT(string == "Shell.elf");
+    ASSERT(string.cstring()[9] == 0);
+
+    Std::String longest { "123456789012345" };
+    ASSERT(longest.size() == Std::String::inline_capacity);
+    ASSERT(longest == "123456789012345");
+
+    ASSERT(Tests::allocation_count() == before);
+}
+
+TEST_CASE(string_heap)
+{
+    size_t before = Tests::allocation_count();
+
+    Std::String string = "Userland/Shell.1.elf";
+    ASSERT(string.size() == 20);
+    ASSERT(string == "Userland/Shell.1.elf");
+    ASSERT(string.cstring()[20] == 0);
+
+    ASSERT(Tests::allocation_count() == before + 1);
+}
+
+TEST_CASE(string_copy)
+{
+    Std::String short_string = "bin";
+    Std::String long_string = "/home/user/Documents";
+
+    Std::String short_copy = short_string;
+    Std::String long_copy = long_string;
+
+    ASSERT(short_copy == "bin");
+    ASSERT(long_copy == "/home/user/Documents");
+    ASSERT(long_copy.data() != long_string.data());
+
+    short_copy = long_string;
+    ASSERT(short_copy == "/home/user/Documents");
+
+    long_copy = short_string;
+    ASSERT(long_copy == "bin");
+
+    long_copy = long_copy;
+    ASSERT(long_copy == "bin");
+
+    ASSERT(short_string == "bin");
+    ASSERT(long_string == "/home/user/Documents");
+}
+
+TEST_CASE(string_move)
+{
+    Std::String short_string = "dev";
+    Std::String long_string = "/home/user/Documents";
+    const char *long_data = long_string.cstring();
+
+    size_t before = Tests::allocation_count();
+
+    Std::String short_moved = move(short_string);
+    Std::String long_moved = move(long_string);
+
+    ASSERT(Tests::allocation_count() == before);
+
+    ASSERT(short_moved == "dev");
+    ASSERT(long_moved == "/home/user/Documents");
+    ASSERT(long_moved.cstring() == long_data);
+
+    ASSERT(short_string.size() == 0 && short_string == "");
+    ASSERT(long_string.size() == 0 && long_string == "");
+
+    short_moved = move(long_moved);
+    ASSERT(short_moved == "/home/user/Documents");
+    ASSERT(long_moved == "");
+
+    short_moved = Std::String { "tty" };
+    ASSERT(short_moved == "tty");
+}
+
+TEST_CASE(string_path_allocations)
+{
+    // Previously, every component was a separate heap allocation in addition to the vector, this
+    // resulted in three allocations.  Now short paths are stored inline in 'Path' itself.
+
+    size_t before = Tests::allocation_count();
+    {
+        Std::Path path { "/bin/Shell.elf" };
+        ASSERT(path.components().size() == 2);
+        ASSERT(path.filename() == "Shell.elf");
+    }
+    ASSERT(Tests::allocation_count() - before == 0);
+}
+
+TEST_MAIN();
@@ -29,4 +29,18 @@ TEST_CASE(stringbuilder_exceed_inline_capacity)
         ASSERT(string.data()[i] == 'a' + i % 26);
 }
 
+TEST_CASE(stringbuilder_append_view_exceeds_inline_capacity)
+{
+    Std::StringBuilder builder;
+
+    std::string expected;
+    for (usize i = 0; i < 100; ++i) {
+        builder.append("0123456789");
+        expected += "0123456789";
+    }
+
+    ASSERT(builder.size() == 1000);
+    ASSERT((builder.view() == Std::StringView { expected.data(), expected.size() }));
+}
+
 TEST_MAIN();
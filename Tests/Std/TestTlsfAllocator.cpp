@@ -0,0 +1,211 @@
+#include <Tests/TestSuite.hpp>
+
+#include <Std/TlsfAllocator.hpp>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+TEST_CASE(tlsfallocator)
+{
+    alignas(16) std::array<uint8_t, 0x1000> heap;
+
+    Std::TlsfAllocator mem { { heap.data(), heap.size() } };
+    auto before = mem.statistics();
+
+    u8 *pointer1 = mem.allocate(32);
+    u8 *pointer2 = mem.allocate(64);
+    u8 *pointer3 = mem.allocate(32);
+    std::memset(pointer1, 0x11, 32);
+    std::memset(pointer2, 0x22, 64);
+    std::memset(pointer3, 0x33, 32);
+    mem.heap_check();
+
+    // Freed blocks are found again for requests of the same size
+    mem.deallocate(pointer2);
+    mem.heap_check();
+    ASSERT(mem.allocate(64) == pointer2);
+
+    for (usize index = 0; index < 32; ++index)
+        ASSERT(pointer1[index] == 0x11 && pointer3[index] == 0x33);
+
+    mem.deallocate(pointer1);
+    mem.deallocate(pointer2);
+    mem.deallocate(pointer3);
+    mem.heap_check();
+
+    auto after = mem.statistics();
+    ASSERT(after.m_avaliable_memory == before.m_avaliable_memory);
+    ASSERT(after.m_largest_continous_block == before.m_largest_continous_block);
+}
+
+TEST_CASE(tlsfallocator_unaligned_heap)
+{
+    alignas(16) std::array<uint8_t, 0x200> heap;
+
+    Std::TlsfAllocator mem { { heap.data() + 3, heap.size() - 5 } };
+
+    u8 *pointer = mem.allocate(100);
+    ASSERT(uptr(pointer) % sizeof(usize) == 0);
+    ASSERT(pointer >= heap.data() + 3 && pointer + 100 <= heap.data() + heap.size() - 2);
+
+    mem.deallocate(pointer);
+    mem.heap_check();
+}
+
+TEST_CASE(tlsfallocator_large_blocks)
+{
+    std::vector<u8> heap(0x40000);
+
+    Std::TlsfAllocator mem { { heap.data(), heap.size() } };
+
+    // The request is rounded up to the next list, this must still fit into the heap
+    u8 *pointer1 = mem.allocate(0x20000);
+    u8 *pointer2 = mem.allocate(0x10000);
+    std::memset(pointer1, 0x11, 0x20000);
+    std::memset(pointer2, 0x22, 0x10000);
+    mem.heap_check();
+
+    mem.deallocate(pointer1);
+    mem.deallocate(pointer2);
+    mem.heap_check();
+
+    ASSERT(mem.statistics().m_largest_continous_block > 0x3f000);
+
+    // On the host, this is rounded up past the last list, it must fail instead of indexing past the lists
+    ASSERT(mem.try_allocate((usize(1) << 32) - 0x100) == nullptr);
+}
+
+TEST_CASE(tlsfallocator_reallocate)
+{
+    alignas(16) std::array<uint8_t, 0x1000> heap;
+
+    Std::TlsfAllocator mem { { heap.data(), heap.size() } };
+
+    u8 *pointer1 = mem.allocate(256);
+    u8 *pointer2 = mem.allocate(256);
+    std::memset(pointer1, 0x11, 256);
+    std::memset(pointer2, 0x22, 256);
+
+    // The last block grows into the rest of the heap without moving
+    ASSERT(mem.reallocate(pointer2, 1024) == pointer2);
+    mem.heap_check();
+
+    // The following block is in use, thus the block has to move
+    u8 *pointer3 = mem.reallocate(pointer1, 512);
+    ASSERT(pointer3 != pointer1);
+    for (usize index = 0; index < 256; ++index)
+        ASSERT(pointer3[index] == 0x11);
+    mem.heap_check();
+
+    // Shrinking substantially returns the tail
+    auto before = mem.statistics();
+    ASSERT(mem.reallocate(pointer2, 64) == pointer2);
+    for (usize index = 0; index < 64; ++index)
+        ASSERT(pointer2[index] == 0x22);
+    ASSERT(mem.statistics().m_avaliable_memory > before.m_avaliable_memory);
+    mem.heap_check();
+
+    mem.deallocate(pointer2);
+    mem.deallocate(pointer3);
+    mem.heap_check();
+}
+
+TEST_CASE(tlsfallocator_random)
+{
+    alignas(16) std::array<uint8_t, 0x10000> heap;
+
+    Std::TlsfAllocator mem { { heap.data(), heap.size() } };
+    auto before = mem.statistics();
+
+    std::mt19937 prng { 1337 };
+    std::vector<std::pair<u8*, usize>> allocations;
+
+    for (usize round = 0; round < 5000; ++round) {
+        usize action = prng() % 8;
+
+        if (allocations.empty() || (action < 4 && allocations.size() < 100)) {
+            usize size = prng() % 4 == 0 ? 1 + prng() % 2048 : 1 + prng() % 128;
+
+            u8 *pointer = mem.allocate(size);
+            std::memset(pointer, u8(size), size);
+
+            allocations.emplace_back(pointer, size);
+        } else if (action < 7) {
+            usize index = prng() % allocations.size();
+            auto [pointer, size] = allocations[index];
+
+            for (usize offset = 0; offset < size; ++offset)
+                ASSERT(pointer[offset] == u8(size));
+
+            mem.deallocate(pointer);
+            allocations.erase(allocations.begin() + index);
+        } else {
+            auto& [pointer, size] = allocations[prng() % allocations.size()];
+            usize new_size = 1 + prng() % 512;
+
+            pointer = mem.reallocate(pointer, new_size);
+            for (usize offset = 0; offset < std::min(size, new_size); ++offset)
+                ASSERT(pointer[offset] == u8(size));
+
+            size = new_size;
+            std::memset(pointer, u8(size), size);
+        }
+
+        mem.heap_check();
+    }
+
+    for (auto [pointer, size] : allocations)
+        mem.deallocate(pointer);
+    mem.heap_check();
+
+    auto after = mem.statistics();
+    ASSERT(after.m_avaliable_memory == before.m_avaliable_memory);
+    ASSERT(after.m_largest_continous_block == before.m_largest_continous_block);
+}
+
+TEST_CASE(tlsfallocator_regions)
+{
+    alignas(16) std::array<uint8_t, 0x400> heap;
+    alignas(16) std::array<uint8_t, 0x1000> region1;
+    alignas(16) std::array<uint8_t, 0x1000> region2;
+
+    Std::TlsfAllocator mem { { heap.data(), heap.size() } };
+
+    // The initial heap can not serve this
+    ASSERT(mem.try_allocate(0x800) == nullptr);
+
+    // Unaligned regions are fine, too
+    mem.add_region({ region1.data() + 1, region1.size() - 1 });
+    mem.add_region({ region2.data(), region2.size() });
+    ASSERT(mem.heap_size() == heap.size() + region1.size() + region2.size() - 1);
+    mem.heap_check();
+
+    u8 *pointer1 = mem.allocate(0x800);
+    u8 *pointer2 = mem.allocate(0x800);
+    u8 *pointer3 = mem.allocate(0x100);
+    mem.heap_check();
+
+    // Blocks of different regions are never merged
+    ASSERT(mem.take_free_region().is_empty());
+    mem.deallocate(pointer3);
+    mem.deallocate(pointer1);
+    mem.heap_check();
+
+    // Only a region that is entirely free can be taken
+    Std::Bytes region = mem.take_free_region();
+    ASSERT(!region.is_empty());
+    ASSERT(mem.take_free_region().is_empty());
+    mem.heap_check();
+
+    mem.deallocate(pointer2);
+    Std::Bytes other_region = mem.take_free_region();
+    ASSERT(!other_region.is_empty() && other_region.data() != region.data());
+    ASSERT(mem.take_free_region().is_empty());
+
+    ASSERT(mem.heap_size() == heap.size());
+    mem.heap_check();
+}
+
+TEST_MAIN();
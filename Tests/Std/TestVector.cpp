@@ -1,6 +1,8 @@
 #include <Tests/TestSuite.hpp>
 
 #include <Std/Vector.hpp>
+#include <Std/String.hpp>
+#include <Std/RefPtr.hpp>
 
 TEST_CASE(vector_default)
 {
@@ -129,4 +131,219 @@ TEST_CASE(vector_exceed_inline_capacity)
         ASSERT(vec.data()[i] == i % 13);
 }
 
+TEST_CASE(vector_inline_move)
+{
+    Std::Vector<Tests::Tracker, 4> vec1;
+    vec1.append(1);
+    vec1.append(2);
+
+    Tests::Tracker::clear();
+
+    Std::Vector<Tests::Tracker, 4> vec2 { move(vec1) };
+
+    Tests::Tracker::assert(0, 2, 0, 2);
+
+    ASSERT(vec1.size() == 0);
+    ASSERT(vec2.size() == 2);
+    ASSERT(vec2[0].m_value == 1);
+    ASSERT(vec2[1].m_value == 2);
+}
+
+TEST_CASE(vector_inline_alignment)
+{
+    struct Small {
+        char m_char;
+        Std::Vector<u64, 3> m_vector;
+    };
+
+    Small small;
+    small.m_vector.append(1);
+
+    ASSERT(usize(small.m_vector.data()) % alignof(u64) == 0);
+}
+
+TEST_CASE(vector_relocate_strings)
+{
+    Std::Vector<Std::String> vec;
+
+    for (usize index = 0; index < 100; ++index)
+        vec.append(Std::String::format("component-{}-with-a-long-name", index));
+
+    for (usize index = 0; index < 100; ++index)
+        ASSERT(vec[index] == Std::String::format("component-{}-with-a-long-name", index));
+}
+
+TEST_CASE(vector_relocate_refptr)
+{
+    struct Object : Std::RefCounted<Object> {
+        int m_value;
+    };
+
+    auto object = Object::construct();
+
+    {
+        Std::Vector<Std::RefPtr<Object>, 2> vec;
+        for (usize index = 0; index < 50; ++index)
+            vec.append(object);
+
+        ASSERT(object->refcount() == 51);
+
+        vec.erase(10, 20);
+        ASSERT(object->refcount() == 31);
+
+        vec.shrink_to_fit();
+        ASSERT(vec.capacity() == 30);
+        ASSERT(object->refcount() == 31);
+    }
+
+    ASSERT(object->refcount() == 1);
+}
+
+TEST_CASE(vector_extend_bulk)
+{
+    Std::Vector<int, 4> vec;
+
+    int values[] = { 1, 2, 3, 4, 5, 6 };
+    vec.extend({ values, 3 });
+    vec.extend({ values + 3, 3 });
+
+    ASSERT(vec.size() == 6);
+    for (usize index = 0; index < 6; ++index)
+        ASSERT(vec[index] == values[index]);
+}
+
+TEST_CASE(vector_append_own_element)
+{
+    Std::Vector<Std::String> vec;
+    vec.append("/dev/tty-with-a-long-name");
+
+    for (usize index = 0; index < 10; ++index)
+        vec.append(vec[0]);
+
+    for (usize index = 0; index < vec.size(); ++index)
+        ASSERT(vec[index] == "/dev/tty-with-a-long-name");
+}
+
+TEST_CASE(vector_insert)
+{
+    Std::Vector<int> vec;
+    vec.append(1);
+    vec.append(4);
+
+    vec.insert(1, 3);
+    vec.insert(1, 2);
+    vec.insert(0, 0);
+    vec.insert(5, 5);
+
+    ASSERT(vec.size() == 6);
+    for (usize index = 0; index < 6; ++index)
+        ASSERT(vec[index] == int(index));
+
+    int values[] = { 10, 11, 12 };
+    vec.insert(2, { values, 3 });
+
+    int expected[] = { 0, 1, 10, 11, 12, 2, 3, 4, 5 };
+    ASSERT(vec.size() == 9);
+    for (usize index = 0; index < 9; ++index)
+        ASSERT(vec[index] == expected[index]);
+}
+
+TEST_CASE(vector_insert_tracker)
+{
+    Std::Vector<Tests::Tracker> vec;
+    vec.reserve(8);
+
+    vec.append(1);
+    vec.append(3);
+
+    Tests::Tracker::clear();
+
+    vec.insert(1, Tests::Tracker { 2 });
+
+    // The last element is shifted back and the temporary is moved into place
+    Tests::Tracker::assert(1, 2, 0, 2);
+
+    ASSERT(vec.size() == 3);
+    ASSERT(vec[0].m_value == 1);
+    ASSERT(vec[1].m_value == 2);
+    ASSERT(vec[2].m_value == 3);
+}
+
+TEST_CASE(vector_erase)
+{
+    Std::Vector<Tests::Tracker> vec;
+    for (int index = 0; index < 6; ++index)
+        vec.append(index);
+
+    Tests::Tracker::clear();
+
+    vec.erase(1, 2);
+
+    Tests::Tracker::assert(0, 3, 0, 2);
+
+    ASSERT(vec.size() == 4);
+    ASSERT(vec[0].m_value == 0);
+    ASSERT(vec[1].m_value == 3);
+    ASSERT(vec[2].m_value == 4);
+    ASSERT(vec[3].m_value == 5);
+
+    vec.erase(3);
+    ASSERT(vec.size() == 3);
+    ASSERT(vec[2].m_value == 4);
+}
+
+TEST_CASE(vector_reserve_exact)
+{
+    Std::Vector<int> vec;
+
+    vec.reserve(5);
+    ASSERT(vec.capacity() == 5);
+
+    vec.reserve(3);
+    ASSERT(vec.capacity() == 5);
+}
+
+TEST_CASE(vector_shrink_to_fit)
+{
+    Std::Vector<int, 4> vec;
+    for (int index = 0; index < 20; ++index)
+        vec.append(index);
+
+    vec.erase(3, 17);
+    vec.shrink_to_fit();
+
+    // The remaining elements fit inline again
+    ASSERT(vec.capacity() == 4);
+    ASSERT(vec.size() == 3);
+    ASSERT(vec[0] == 0 && vec[1] == 1 && vec[2] == 2);
+
+    Std::Vector<int> empty;
+    empty.append(1);
+    empty.erase(0);
+    empty.shrink_to_fit();
+    ASSERT(empty.capacity() == 0);
+}
+
+TEST_CASE(vector_try_grow)
+{
+    Std::Vector<int, 4> vec;
+
+    ASSERT(vec.try_grow(4));
+    ASSERT(!vec.try_grow(5));
+
+    vec.reserve(16);
+    vec.append(1);
+
+    int *data = vec.data();
+
+    // Only succeeds if the allocation happens to be large enough, but must never move the elements
+    if (vec.try_grow(17))
+        ASSERT(vec.capacity() == 17);
+    else
+        ASSERT(vec.capacity() == 16);
+
+    ASSERT(vec.data() == data);
+    ASSERT(vec[0] == 1);
+}
+
 TEST_MAIN();
@@ -1,5 +1,12 @@
 #include <Tests/TestSuite.hpp>
 
+#include <atomic>
+
+// Provided by the address sanitizer runtime, the header is not always installed.
+extern "C" int __sanitizer_install_malloc_and_free_hooks(
+    void (*malloc_hook)(const volatile void*, size_t),
+    void (*free_hook)(const volatile void*));
+
 namespace Tests
 {
     size_t Tracker::m_create_count = 0;
@@ -7,3 +14,28 @@ namespace Tests
     size_t Tracker::m_move_count = 0;
     size_t Tracker::m_destroy_count = 0;
 }
+
+namespace Tests
+{
+    // Some tests allocate from multiple threads
+    static std::atomic<size_t> g_allocation_count = 0;
+
+    static void malloc_hook(const volatile void*, size_t)
+    {
+        ++g_allocation_count;
+    }
+    static void free_hook(const volatile void*)
+    {
+    }
+
+    [[gnu::constructor]]
+    static void install_allocation_hooks()
+    {
+        __sanitizer_install_malloc_and_free_hooks(malloc_hook, free_hook);
+    }
+
+    size_t allocation_count()
+    {
+        return g_allocation_count;
+    }
+}
@@ -57,6 +57,9 @@ namespace Tests
         }
     }
 
+    // Number of heap allocations performed by the process so far, counted through the address sanitizer.
+    size_t allocation_count();
+
     template<typename T, usize Size>
     void dump_span(std::span<T, Size> span)
     {
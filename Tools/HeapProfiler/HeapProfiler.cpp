@@ -0,0 +1,411 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cxxabi.h>
+#include <elf.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fmt/format.h>
+
+#include <LibElf/MemoryStream.hpp>
+
+#include <Kernel/Interface/HeapTrace.hpp>
+
+using namespace Kernel::HeapTrace;
+
+// Resolves the callers in the events to the functions of the kernel.
+class SymbolTable {
+public:
+    explicit SymbolTable(std::span<const uint8_t> elf)
+        : m_elf(elf)
+    {
+        assert(m_elf.size() >= sizeof(Elf32_Ehdr));
+        assert(memcmp(m_elf.data(), ELFMAG, SELFMAG) == 0);
+        assert(m_elf[EI_CLASS] == ELFCLASS32);
+
+        auto& header = object<Elf32_Ehdr>(0);
+
+        for (size_t index = 0; index < header.e_shnum; ++index) {
+            auto& section_header = object<Elf32_Shdr>(header.e_shoff + index * sizeof(Elf32_Shdr));
+
+            if (section_header.sh_type != SHT_SYMTAB)
+                continue;
+
+            auto& strings_header = object<Elf32_Shdr>(header.e_shoff + section_header.sh_link * sizeof(Elf32_Shdr));
+
+            for (size_t offset = 0; offset + sizeof(Elf32_Sym) <= section_header.sh_size; offset += sizeof(Elf32_Sym)) {
+                auto& symbol = object<Elf32_Sym>(section_header.sh_offset + offset);
+
+                if (ELF32_ST_TYPE(symbol.st_info) != STT_FUNC || symbol.st_value == 0)
+                    continue;
+
+                // The lowest bit marks thumb code
+                m_symbols.push_back({
+                    .m_address = symbol.st_value & ~uint32_t(1),
+                    .m_size = symbol.st_size,
+                    .m_name = reinterpret_cast<const char*>(m_elf.data() + strings_header.sh_offset + symbol.st_name),
+                });
+            }
+        }
+
+        std::sort(m_symbols.begin(), m_symbols.end(), [](auto& lhs, auto& rhs) {
+            return lhs.m_address < rhs.m_address;
+        });
+    }
+
+    std::string lookup(uint32_t address) const
+    {
+        if (address == 0)
+            return "<unknown>";
+
+        address &= ~uint32_t(1);
+
+        auto iterator = std::upper_bound(m_symbols.begin(), m_symbols.end(), address, [](uint32_t address, auto& symbol) {
+            return address < symbol.m_address;
+        });
+
+        if (iterator == m_symbols.begin())
+            return fmt::format("0x{:08x}", address);
+
+        auto& symbol = *--iterator;
+        if (symbol.m_size != 0 && address - symbol.m_address >= symbol.m_size)
+            return fmt::format("0x{:08x}", address);
+
+        return fmt::format("{}+0x{:x}", demangle(symbol.m_name), address - symbol.m_address);
+    }
+
+private:
+    struct Symbol {
+        uint32_t m_address;
+        uint32_t m_size;
+        const char *m_name;
+    };
+
+    static std::string demangle(const char *name)
+    {
+        int status;
+        std::unique_ptr<char, decltype(&free)> demangled { abi::__cxa_demangle(name, nullptr, nullptr, &status), free };
+
+        if (status != 0)
+            return name;
+
+        return demangled.get();
+    }
+
+    template<typename T>
+    const T& object(size_t offset)
+    {
+        assert(offset + sizeof(T) <= m_elf.size());
+        return *reinterpret_cast<const T*>(m_elf.data() + offset);
+    }
+
+    std::span<const uint8_t> m_elf;
+    std::vector<Symbol> m_symbols;
+};
+
+struct TimedEvent {
+    Event m_event;
+
+    // Microseconds since boot, without wrapping
+    uint64_t m_time;
+};
+
+// The events are mixed with the other console output, everything else is skipped.
+struct Capture {
+    explicit Capture(std::span<const uint8_t> data)
+    {
+        uint64_t epoch = 0;
+        uint32_t previous_timestamp = 0;
+
+        size_t offset = 0;
+        while (offset < data.size()) {
+            auto *magic_begin = reinterpret_cast<const uint8_t*>(memchr(data.data() + offset, magic[0], data.size() - offset));
+            if (magic_begin == nullptr)
+                break;
+
+            offset = magic_begin - data.data();
+
+            std::optional<Event> event = try_decode(data.subspan(offset));
+            if (!event.has_value()) {
+                offset += 1;
+                continue;
+            }
+
+            if (event->m_timestamp < previous_timestamp)
+                epoch += uint64_t(1) << 32;
+            previous_timestamp = event->m_timestamp;
+
+            m_events.push_back({ *event, epoch + event->m_timestamp });
+            offset += sizeof(Event);
+        }
+
+        // Reported by the kernel log if its buffer overflowed
+        std::string_view text { reinterpret_cast<const char*>(data.data()), data.size() };
+        for (size_t position = 0; (position = text.find("[KernelLog] Dropped", position)) != std::string_view::npos; ++position)
+            ++m_dropped_reports;
+    }
+
+    static std::optional<Event> try_decode(std::span<const uint8_t> data)
+    {
+        if (data.size() < sizeof(Event))
+            return std::nullopt;
+
+        Event event;
+        memcpy(&event, data.data(), sizeof(event));
+
+        if (event.m_magic[1] != magic[1] || event.m_reserved != 0)
+            return std::nullopt;
+        if (uint8_t(event.m_kind) == 0 || uint8_t(event.m_kind) > last_kind)
+            return std::nullopt;
+
+        return event;
+    }
+
+    std::vector<TimedEvent> m_events;
+    size_t m_dropped_reports = 0;
+};
+
+// The heap as seen through the events.  Sizes are the requested ones, the headers of the blocks are not known.
+class HeapState {
+public:
+    struct Block {
+        uint32_t m_size;
+        uint32_t m_caller;
+    };
+
+    void apply(const Event& event)
+    {
+        switch (event.m_kind) {
+        case Kind::Start:
+            m_untracked_bytes = event.m_size;
+            break;
+        case Kind::Allocate:
+            add_block(event.m_pointer, event.m_size, event.m_caller);
+            break;
+        case Kind::Deallocate:
+            remove_block(event.m_pointer);
+            break;
+        case Kind::Reallocate:
+            remove_block(event.m_pointer);
+            add_block(event.m_new_pointer, event.m_size, event.m_caller);
+            break;
+        case Kind::AddRegion:
+            m_regions[event.m_pointer] = event.m_size;
+            m_region_bytes += event.m_size;
+            break;
+        case Kind::RemoveRegion:
+            if (auto iterator = m_regions.find(event.m_pointer); iterator != m_regions.end()) {
+                m_region_bytes -= iterator->second;
+                m_regions.erase(iterator);
+            }
+            break;
+        }
+    }
+
+    uint64_t used_bytes() const { return m_live_bytes + m_untracked_bytes; }
+
+    // The largest range in any region that is not covered by a known block
+    uint64_t largest_free_range() const
+    {
+        uint64_t largest = 0;
+
+        for (auto [region_begin, region_size] : m_regions) {
+            uint64_t region_end = uint64_t(region_begin) + region_size;
+            uint64_t position = region_begin;
+
+            for (auto iterator = m_blocks.lower_bound(region_begin); iterator != m_blocks.end() && iterator->first < region_end; ++iterator) {
+                if (iterator->first > position)
+                    largest = std::max<uint64_t>(largest, iterator->first - position);
+
+                position = std::max<uint64_t>(position, uint64_t(iterator->first) + iterator->second.m_size);
+            }
+
+            if (region_end > position)
+                largest = std::max<uint64_t>(largest, region_end - position);
+        }
+
+        return largest;
+    }
+
+    // Combines the live blocks of each call site, the largest first
+    std::vector<std::pair<uint32_t, std::pair<uint64_t, size_t>>> by_caller() const
+    {
+        std::map<uint32_t, std::pair<uint64_t, size_t>> callers;
+        for (auto& [pointer, block] : m_blocks) {
+            callers[block.m_caller].first += block.m_size;
+            callers[block.m_caller].second += 1;
+        }
+
+        std::vector<std::pair<uint32_t, std::pair<uint64_t, size_t>>> sorted { callers.begin(), callers.end() };
+        std::sort(sorted.begin(), sorted.end(), [](auto& lhs, auto& rhs) {
+            return lhs.second.first > rhs.second.first;
+        });
+
+        return sorted;
+    }
+
+    std::map<uint32_t, Block> m_blocks;
+    std::map<uint32_t, uint32_t> m_regions;
+
+    uint64_t m_live_bytes = 0;
+    uint64_t m_untracked_bytes = 0;
+    uint64_t m_region_bytes = 0;
+
+    // Frees of blocks that were allocated before the trace started or whose events were dropped
+    size_t m_unknown_frees = 0;
+
+private:
+    void add_block(uint32_t pointer, uint32_t size, uint32_t caller)
+    {
+        // The free event was lost, the address was reused
+        if (auto iterator = m_blocks.find(pointer); iterator != m_blocks.end())
+            m_live_bytes -= iterator->second.m_size;
+
+        m_blocks[pointer] = { size, caller };
+        m_live_bytes += size;
+    }
+
+    void remove_block(uint32_t pointer)
+    {
+        auto iterator = m_blocks.find(pointer);
+        if (iterator == m_blocks.end()) {
+            ++m_unknown_frees;
+            return;
+        }
+
+        m_live_bytes -= iterator->second.m_size;
+        m_blocks.erase(iterator);
+    }
+};
+
+struct Sample {
+    uint64_t m_time;
+    uint64_t m_used_bytes;
+    size_t m_block_count;
+    uint64_t m_region_bytes;
+    uint64_t m_largest_free_range;
+};
+
+static std::string bar(uint64_t value, uint64_t maximum, size_t width)
+{
+    size_t length = maximum == 0 ? 0 : size_t(value * width / maximum);
+    return std::string(length, '#');
+}
+
+static void print_callers(const SymbolTable& symbols, const HeapState& state, size_t limit)
+{
+    fmt::print("  {:>10} {:>8}  {}\n", "bytes", "blocks", "caller");
+
+    auto callers = state.by_caller();
+    for (size_t index = 0; index < std::min(limit, callers.size()); ++index) {
+        auto& [caller, totals] = callers[index];
+        fmt::print("  {:>10} {:>8}  {}\n", totals.first, totals.second, symbols.lookup(caller));
+    }
+
+    if (callers.size() > limit)
+        fmt::print("  ... {} more call sites\n", callers.size() - limit);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3 && argc != 4) {
+        fmt::print(stderr, "usage: {} <Kernel.elf> <capture> [<samples>]\n", argv[0]);
+        return 1;
+    }
+
+    SymbolTable symbols { Elf::mmap_file(argv[1]) };
+    Capture capture { Elf::mmap_file(argv[2]) };
+
+    size_t sample_count = argc == 4 ? std::max(1, atoi(argv[3])) : 24;
+
+    auto& events = capture.m_events;
+    if (events.empty()) {
+        fmt::print(stderr, "No heap trace events found, was the kernel built with KERNEL_HEAP_TRACE?\n");
+        return 1;
+    }
+
+    uint64_t begin_time = events.front().m_time;
+    uint64_t end_time = events.back().m_time;
+    uint64_t duration = std::max<uint64_t>(end_time - begin_time, 1);
+
+    // First pass: sample the heap at regular intervals and find the peak
+    HeapState state;
+    std::vector<Sample> samples;
+
+    size_t peak_index = 0;
+    uint64_t peak_bytes = 0;
+
+    auto take_sample = [&](uint64_t time) {
+        samples.push_back({
+            .m_time = time - begin_time,
+            .m_used_bytes = state.used_bytes(),
+            .m_block_count = state.m_blocks.size(),
+            .m_region_bytes = state.m_region_bytes,
+            .m_largest_free_range = state.largest_free_range(),
+        });
+    };
+
+    for (size_t index = 0; index < events.size(); ++index) {
+        state.apply(events[index].m_event);
+
+        if (state.used_bytes() > peak_bytes) {
+            peak_bytes = state.used_bytes();
+            peak_index = index;
+        }
+
+        // The state holds until the next event
+        uint64_t next_time = index + 1 < events.size() ? events[index + 1].m_time : end_time + 1;
+        while (samples.size() < sample_count && begin_time + samples.size() * duration / sample_count < next_time)
+            take_sample(begin_time + samples.size() * duration / sample_count);
+    }
+    take_sample(end_time);
+
+    fmt::print("Heap trace: {} events over {:.3f} s\n", events.size(), double(end_time - begin_time) / 1e6);
+    if (capture.m_dropped_reports > 0)
+        fmt::print("  WARNING: The kernel log dropped messages {} times, some events are missing\n", capture.m_dropped_reports);
+    if (state.m_unknown_frees > 0)
+        fmt::print("  {} frees of blocks that were not allocated during the trace\n", state.m_unknown_frees);
+    fmt::print("  Sizes are as requested, the overhead of the allocator is not included\n");
+
+    uint64_t maximum_used = 0;
+    for (auto& sample : samples)
+        maximum_used = std::max(maximum_used, sample.m_used_bytes);
+
+    fmt::print("\nLive heap over time:\n");
+    fmt::print("  {:>10} {:>10} {:>8}\n", "time [ms]", "bytes", "blocks");
+    for (auto& sample : samples)
+        fmt::print("  {:>10.1f} {:>10} {:>8}  {}\n", double(sample.m_time) / 1e3, sample.m_used_bytes, sample.m_block_count, bar(sample.m_used_bytes, maximum_used, 40));
+
+    // Second pass: the state at the peak
+    HeapState peak_state;
+    for (size_t index = 0; index <= peak_index; ++index)
+        peak_state.apply(events[index].m_event);
+
+    fmt::print("\nPeak usage: {} bytes in {} blocks at {:.1f} ms\n", peak_bytes, peak_state.m_blocks.size(), double(events[peak_index].m_time - begin_time) / 1e3);
+    if (peak_state.m_untracked_bytes > 0)
+        fmt::print("  {} bytes were allocated before the trace started\n", peak_state.m_untracked_bytes);
+    print_callers(symbols, peak_state, 10);
+
+    fmt::print("\nLive at the end of the capture, by call site:\n");
+    if (state.m_blocks.empty())
+        fmt::print("  Nothing\n");
+    else
+        print_callers(symbols, state, 20);
+
+    // Blocks that were allocated before the trace started are not known, the free ranges appear larger than they are
+    fmt::print("\nFragmentation over time:\n");
+    fmt::print("  {:>10} {:>10} {:>10} {:>10} {:>6}\n", "time [ms]", "heap", "free", "largest", "frag");
+    for (auto& sample : samples) {
+        uint64_t free_bytes = sample.m_region_bytes > sample.m_used_bytes ? sample.m_region_bytes - sample.m_used_bytes : 0;
+        double fragmentation = free_bytes == 0 ? 0.0 : 1.0 - double(std::min(sample.m_largest_free_range, free_bytes)) / double(free_bytes);
+
+        fmt::print("  {:>10.1f} {:>10} {:>10} {:>10} {:>5.1f}%\n", double(sample.m_time) / 1e3, sample.m_region_bytes, free_bytes, sample.m_largest_free_range, fragmentation * 100);
+    }
+}
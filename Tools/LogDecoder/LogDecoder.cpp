@@ -0,0 +1,367 @@
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <elf.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include <LibElf/MemoryStream.hpp>
+
+#include <Kernel/Interface/BinaryLog.hpp>
+#include <Kernel/Interface/HeapTrace.hpp>
+
+using namespace Kernel::BinaryLog;
+
+// Looks up the format strings of the kernel, see 'Kernel/Interface/BinaryLog.hpp'.
+class StringTable {
+public:
+    explicit StringTable(std::span<const uint8_t> elf)
+        : m_elf(elf)
+    {
+        assert(m_elf.size() >= sizeof(Elf32_Ehdr));
+        assert(memcmp(m_elf.data(), ELFMAG, SELFMAG) == 0);
+        assert(m_elf[EI_CLASS] == ELFCLASS32);
+
+        auto& header = object<Elf32_Ehdr>(0);
+        auto& names_header = object<Elf32_Shdr>(header.e_shoff + header.e_shstrndx * sizeof(Elf32_Shdr));
+
+        for (size_t index = 0; index < header.e_shnum; ++index) {
+            auto& section_header = object<Elf32_Shdr>(header.e_shoff + index * sizeof(Elf32_Shdr));
+
+            if (section_header.sh_type != SHT_PROGBITS)
+                continue;
+
+            std::string_view name { reinterpret_cast<const char*>(m_elf.data() + names_header.sh_offset + section_header.sh_name) };
+
+            Section section {
+                .m_address = section_header.sh_addr,
+                .m_data = m_elf.subspan(section_header.sh_offset, section_header.sh_size),
+            };
+
+            // The strings section overlaps with anything else that starts at address zero
+            if (name == section_name)
+                m_sections.insert(m_sections.begin(), section);
+            else if (section_header.sh_flags & SHF_ALLOC)
+                m_sections.push_back(section);
+        }
+    }
+
+    std::optional<std::string_view> lookup(uint32_t address) const
+    {
+        for (auto& section : m_sections) {
+            if (address < section.m_address || address - section.m_address >= section.m_data.size())
+                continue;
+
+            auto data = section.m_data.subspan(address - section.m_address);
+
+            auto *end = reinterpret_cast<const uint8_t*>(memchr(data.data(), 0, data.size()));
+            if (end == nullptr)
+                return std::nullopt;
+
+            return std::string_view { reinterpret_cast<const char*>(data.data()), size_t(end - data.data()) };
+        }
+
+        return std::nullopt;
+    }
+
+private:
+    struct Section {
+        uint32_t m_address;
+        std::span<const uint8_t> m_data;
+    };
+
+    template<typename T>
+    const T& object(size_t offset)
+    {
+        assert(offset + sizeof(T) <= m_elf.size());
+        return *reinterpret_cast<const T*>(m_elf.data() + offset);
+    }
+
+    std::span<const uint8_t> m_elf;
+    std::vector<Section> m_sections;
+};
+
+// Renders the arguments of a record the same way 'Std::format_to' would have on the device.
+class RecordFormatter {
+public:
+    explicit RecordFormatter(std::span<const uint8_t> arguments)
+        : m_arguments(arguments)
+    {
+    }
+
+    std::optional<std::string> format(std::string_view fmtstr)
+    {
+        std::string output;
+
+        for (size_t index = 0; index < fmtstr.size(); ++index) {
+            char ch = fmtstr[index];
+
+            if ((ch == '{' || ch == '}') && index + 1 < fmtstr.size() && fmtstr[index + 1] == ch) {
+                output.push_back(ch);
+                ++index;
+                continue;
+            }
+
+            if (ch != '{') {
+                output.push_back(ch);
+                continue;
+            }
+
+            size_t end = fmtstr.find('}', index);
+            if (end == std::string_view::npos)
+                return std::nullopt;
+
+            bool decimal = fmtstr.substr(index + 1, end - index - 1) == ":d";
+            if (!append_argument(output, decimal))
+                return std::nullopt;
+
+            index = end;
+        }
+
+        // Every argument must be consumed, otherwise the record does not belong to this format string
+        if (m_offset != m_arguments.size())
+            return std::nullopt;
+
+        return output;
+    }
+
+private:
+    bool append_argument(std::string& output, bool decimal)
+    {
+        uint8_t tag;
+        if (!read(&tag, sizeof(tag)))
+            return false;
+
+        size_t size = tag & tag_size_mask;
+
+        switch (Tag(tag & tag_kind_mask)) {
+        case Tag::Unsigned:
+        case Tag::Pointer:
+            return append_integer(output, size, false, decimal);
+        case Tag::Signed:
+            return append_integer(output, size, true, decimal);
+        case Tag::Char: {
+            char value;
+            if (size != 1 || !read(&value, 1))
+                return false;
+
+            output.push_back(value);
+            return true;
+        }
+        case Tag::Bool: {
+            uint8_t value;
+            if (size != 1 || !read(&value, 1))
+                return false;
+
+            output.append(value ? "true" : "false");
+            return true;
+        }
+        case Tag::String: {
+            uint16_t length;
+            if (!read(&length, sizeof(length)) || m_offset + length > m_arguments.size())
+                return false;
+
+            output.append(reinterpret_cast<const char*>(m_arguments.data() + m_offset), length);
+            m_offset += length;
+            return true;
+        }
+        }
+
+        return false;
+    }
+
+    bool append_integer(std::string& output, size_t size, bool is_signed, bool decimal)
+    {
+        if (size != 1 && size != 2 && size != 4 && size != 8)
+            return false;
+
+        // Little endian on both sides
+        uint64_t raw = 0;
+        if (!read(&raw, size))
+            return false;
+
+        // Sign extend to 64 bits
+        if (is_signed && size < 8 && (raw >> (size * 8 - 1)) & 1)
+            raw |= ~uint64_t(0) << (size * 8);
+
+        bool negative = false;
+        if (is_signed && int64_t(raw) < 0) {
+            negative = true;
+            raw = uint64_t(0) - raw;
+        }
+
+        if (negative)
+            output.push_back('-');
+
+        if (decimal)
+            output.append(fmt::format("{}", raw));
+        else
+            output.append(fmt::format("0x{:0{}x}", raw & mask(size), size * 2));
+
+        return true;
+    }
+
+    static uint64_t mask(size_t size)
+    {
+        return size == 8 ? ~uint64_t(0) : (uint64_t(1) << (size * 8)) - 1;
+    }
+
+    bool read(void *value, size_t size)
+    {
+        if (m_offset + size > m_arguments.size())
+            return false;
+
+        memcpy(value, m_arguments.data() + m_offset, size);
+        m_offset += size;
+        return true;
+    }
+
+    std::span<const uint8_t> m_arguments;
+    size_t m_offset = 0;
+};
+
+// Records are mixed with text from userland, everything that can not be decoded is passed through.
+class Decoder {
+public:
+    explicit Decoder(const StringTable& strings)
+        : m_strings(strings)
+    {
+    }
+
+    void feed(std::span<const uint8_t> data)
+    {
+        m_buffer.insert(m_buffer.end(), data.begin(), data.end());
+        process(false);
+    }
+
+    void finish()
+    {
+        process(true);
+    }
+
+private:
+    void process(bool at_end)
+    {
+        size_t offset = 0;
+
+        while (offset < m_buffer.size()) {
+            auto *magic_begin = reinterpret_cast<const uint8_t*>(memchr(m_buffer.data() + offset, magic[0], m_buffer.size() - offset));
+            size_t record_offset = magic_begin ? size_t(magic_begin - m_buffer.data()) : m_buffer.size();
+
+            write_text(offset, record_offset);
+            offset = record_offset;
+
+            if (offset == m_buffer.size())
+                break;
+
+            auto record_size = try_decode(offset);
+
+            if (!record_size.has_value()) {
+                // Incomplete, wait for more data unless there is none
+                if (!at_end)
+                    break;
+
+                record_size = 0;
+            }
+
+            if (*record_size == 0) {
+                write_text(offset, offset + 1);
+                offset += 1;
+            } else {
+                offset += *record_size;
+            }
+        }
+
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + offset);
+    }
+
+    // Returns the size of the record if it was decoded, zero if this is not a record or 'std::nullopt' if more
+    // data is required to decide.
+    std::optional<size_t> try_decode(size_t offset)
+    {
+        std::span<const uint8_t> available { m_buffer.data() + offset, m_buffer.size() - offset };
+
+        if (available.size() < 2)
+            return std::nullopt;
+
+        // Events of the heap trace are left to 'Tools/HeapProfiler'
+        if (available[1] == Kernel::HeapTrace::magic[1]) {
+            if (available.size() < sizeof(Kernel::HeapTrace::Event))
+                return std::nullopt;
+            return sizeof(Kernel::HeapTrace::Event);
+        }
+
+        if (available[1] != magic[1])
+            return 0;
+
+        if (available.size() < sizeof(RecordHeader))
+            return std::nullopt;
+
+        RecordHeader header;
+        memcpy(&header, available.data(), sizeof(header));
+
+        auto fmtstr = m_strings.lookup(header.m_string_address);
+        if (!fmtstr.has_value())
+            return 0;
+
+        size_t record_size = sizeof(RecordHeader) + header.m_size;
+        if (available.size() < record_size)
+            return std::nullopt;
+
+        RecordFormatter formatter { available.subspan(sizeof(RecordHeader), header.m_size) };
+
+        auto message = formatter.format(*fmtstr);
+        if (!message.has_value())
+            return 0;
+
+        fmt::print("\e[36m{}\e[0m\n", *message);
+        return record_size;
+    }
+
+    void write_text(size_t begin, size_t end)
+    {
+        if (begin != end)
+            fwrite(m_buffer.data() + begin, 1, end - begin, stdout);
+    }
+
+    const StringTable& m_strings;
+    std::vector<uint8_t> m_buffer;
+};
+
+int main(int argc, char **argv)
+{
+    if (argc != 2 && argc != 3) {
+        fmt::print(stderr, "usage: {} <Kernel.elf> [<capture>]\n", argv[0]);
+        return 1;
+    }
+
+    StringTable strings { Elf::mmap_file(argv[1]) };
+    Decoder decoder { strings };
+
+    int fd = STDIN_FILENO;
+    if (argc == 3) {
+        fd = open(argv[2], O_RDONLY);
+        assert(fd >= 0);
+    }
+
+    // Unbuffered, this is usually attached to a serial port
+    uint8_t buffer[4096];
+    for (;;) {
+        ssize_t retval = read(fd, buffer, sizeof(buffer));
+        assert(retval >= 0);
+
+        if (retval == 0)
+            break;
+
+        decoder.feed({ buffer, size_t(retval) });
+        fflush(stdout);
+    }
+
+    decoder.finish();
+}